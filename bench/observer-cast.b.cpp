@@ -0,0 +1,183 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Benchmark: nonstd::dynamic_observer_cast against dynamic_cast.
+//
+// Events of several types in a hierarchy of a few levels with a mixin base are dispatched
+// by casts from the root type, as in an event loop. For each kind of cast, the time per cast
+// is reported for dynamic_cast and for dynamic_observer_cast: to the exact dynamic type, to
+// an intermediate base of a more derived type, across to the mixin base, and a failing cast.
+// The number of successful casts must agree; the program fails if it does not.
+
+#include "nonstd/observer_cast.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using nonstd::observer_ptr;
+using nonstd::dynamic_observer_cast;
+
+namespace {
+
+// Benchmark parameters, the number of repetitions can be given on the command line:
+
+const std::size_t event_count  = 4096;
+const int         best_of      = 5;
+const long        default_reps = 1000;
+
+// Prevent the optimizer from discarding a computation:
+
+#if defined(__GNUC__) || defined(__clang__)
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    __asm__ __volatile__( "" : : "r,m"( value ) : "memory" );
+}
+#else
+
+volatile long sink;
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    sink = static_cast<long>( sizeof( value ) );
+}
+#endif
+
+// Wall-clock time in nanoseconds:
+
+double now_ns()
+{
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+// The event hierarchy:
+
+struct Event        { virtual ~Event() {} long time = 0; };
+struct Traced       { virtual ~Traced() {} long trace = 0; };
+struct InputEvent   : Event { long device = 0; };
+struct KeyEvent     : InputEvent, Traced { long key = 0; };
+struct MouseEvent   : InputEvent, Traced { long x = 0, y = 0; };
+struct ClickEvent   : MouseEvent { long button = 0; };
+struct DoubleClick  : ClickEvent { long interval = 0; };
+struct TimerEvent   : Event { long id = 0; };
+
+// Time casts of all events, yield the best time per cast in nanoseconds:
+
+template< class Cast >
+double measure( Cast cast, std::vector< Event * > const & events, long reps, long & hits )
+{
+    double best = 0;
+
+    for ( int run = 0; run < best_of; ++run )
+    {
+        long sum = 0;
+        double const start = now_ns();
+
+        for ( long rep = 0; rep < reps; ++rep )
+        {
+            for ( Event * event : events )
+                sum += cast( event );
+
+            do_not_optimize( sum );
+        }
+
+        double const elapsed = now_ns() - start;
+
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+
+        hits = sum;
+    }
+    return best / ( static_cast<double>( reps ) * static_cast<double>( events.size() ) );
+}
+
+// Time a cast to T with dynamic_cast and with dynamic_observer_cast and report:
+
+template< class T >
+int run( char const * name, std::vector< Event * > const & events, long reps )
+{
+    long plain_hits = 0, cached_hits = 0;
+
+    double const plain_ns = measure( []( Event * e )
+    {
+        return dynamic_cast<T *>( e ) != nullptr ? 1L : 0L;
+    }, events, reps, plain_hits );
+
+    double const cached_ns = measure( []( Event * e )
+    {
+        return dynamic_observer_cast<T>( nonstd::make_observer( e ) ) ? 1L : 0L;
+    }, events, reps, cached_hits );
+
+    std::cout << std::fixed << std::setprecision(3) <<
+        std::left  << std::setw(36) << name <<
+        std::right << std::setw(20) << plain_ns << std::setw(28) << cached_ns <<
+        ( plain_hits == cached_hits ? "" : "  (hits mismatch)" ) << "\n";
+
+    return plain_hits == cached_hits ? 0 : 1;
+}
+
+// events of the given type:
+
+template< class T >
+std::vector< Event * > make_events( std::vector< std::unique_ptr<Event> > & store )
+{
+    std::vector< Event * > events;
+
+    for ( std::size_t i = 0; i < event_count; ++i )
+    {
+        store.emplace_back( new T() );
+        events.push_back( store.back().get() );
+    }
+    return events;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    long const reps = argc > 1 ? std::atol( argv[1] ) : default_reps;
+
+    std::cout <<
+        "dynamic_observer_cast benchmark: " << ( nsop_USES_STD_OBSERVER_PTR ? "std::experimental" : "nonstd" ) <<
+        "::observer_ptr, C++ " << nsop_CPLUSPLUS << ", " <<
+        event_count << " events x " << reps << " repetitions, best of " << best_of << "\n\n" <<
+        std::left  << std::setw(36) << "cast" <<
+        std::right << std::setw(20) << "dynamic_cast [ns]" << std::setw(28) << "dynamic_observer_cast [ns]" << "\n";
+
+    std::vector< std::unique_ptr<Event> > store;
+
+    std::vector< Event * > const clicks  = make_events< ClickEvent  >( store );
+    std::vector< Event * > const doubles = make_events< DoubleClick >( store );
+    std::vector< Event * > const keys    = make_events< KeyEvent    >( store );
+
+    int failures = 0;
+
+    failures += run< ClickEvent >( "ClickEvent to ClickEvent (exact)"  , clicks , reps );
+    failures += run< MouseEvent >( "DoubleClick to MouseEvent (down)"  , doubles, reps );
+    failures += run< Traced     >( "DoubleClick to Traced (cross)"     , doubles, reps );
+    failures += run< MouseEvent >( "KeyEvent to MouseEvent (fails)"    , keys   , reps );
+    failures += run< TimerEvent >( "DoubleClick to TimerEvent (fails)" , doubles, reps );
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if 0
+g++ -std=c++11 -O2 -DNDEBUG -I../include -o observer-cast.b.exe observer-cast.b.cpp && observer-cast.b.exe
+g++ -std=c++17 -O2 -DNDEBUG -I../include -o observer-cast.b.exe observer-cast.b.cpp && observer-cast.b.exe
+
+cl -EHsc -O2 -DNDEBUG -I../include observer-cast.b.cpp && observer-cast.b.exe
+#endif
+
+// end of file
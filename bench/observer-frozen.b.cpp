@@ -0,0 +1,175 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Benchmark: membership tests in nonstd::frozen_observer_set against std::unordered_set.
+//
+// The keys are observers of every other object of an array, so that half of the lookups
+// miss. For sets of several sizes, the time per contains() is reported for
+// std::unordered_set with std::hash< observer_ptr<T> >, for std::unordered_set with
+// nonstd::observer_hash and for frozen_observer_set, as well as the time to build the
+// frozen set per key. The number of hits of all sets must agree; the program fails if they
+// do not.
+
+#include "nonstd/observer_frozen.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <unordered_set>
+#include <vector>
+
+using nonstd::observer_ptr;
+using nonstd::observer_hash;
+using nonstd::frozen_observer_set;
+
+namespace {
+
+// Benchmark parameters, the number of repetitions can be given on the command line:
+
+const std::size_t key_counts[] = { 64, 4096, 262144 };
+const std::size_t lookups      = 262144;
+const int         best_of      = 5;
+const long        default_reps = 10;
+
+// Prevent the optimizer from discarding a computation:
+
+#if defined(__GNUC__) || defined(__clang__)
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    __asm__ __volatile__( "" : : "r,m"( value ) : "memory" );
+}
+#else
+
+volatile long sink;
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    sink = static_cast<long>( sizeof( value ) );
+}
+#endif
+
+// Wall-clock time in nanoseconds:
+
+double now_ns()
+{
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+struct Node
+{
+    long value;
+};
+
+// Time the lookups of all probes, yield the best time per lookup in nanoseconds:
+
+template< class Set >
+double measure( Set const & set, std::vector< observer_ptr<Node> > const & probes, long reps, long & hits )
+{
+    double best = 0;
+
+    for ( int run = 0; run < best_of; ++run )
+    {
+        long sum = 0;
+        double const start = now_ns();
+
+        for ( long rep = 0; rep < reps; ++rep )
+        {
+            for ( observer_ptr<Node> key : probes )
+                sum += set.count( key ) != 0;
+
+            do_not_optimize( sum );
+        }
+
+        double const elapsed = now_ns() - start;
+
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+
+        hits = sum;
+    }
+    return best / ( static_cast<double>( reps ) * static_cast<double>( probes.size() ) );
+}
+
+// Build the sets for n keys, time the lookups and report:
+
+int run( std::size_t n, long reps )
+{
+    std::vector< Node > nodes( 2 * n );
+    std::vector< observer_ptr<Node> > keys;
+    std::vector< observer_ptr<Node> > probes( lookups );
+    unsigned long seed = 12345;
+
+    for ( std::size_t i = 0; i < nodes.size(); i += 2 )
+        keys.push_back( nonstd::make_observer( &nodes[i] ) );
+
+    for ( std::size_t i = 0; i < lookups; ++i )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        probes[i] = nonstd::make_observer( &nodes[ ( seed >> 8 ) % nodes.size() ] );
+    }
+
+    std::unordered_set< observer_ptr<Node> > const std_set( keys.begin(), keys.end() );
+    std::unordered_set< observer_ptr<Node>, observer_hash > const mix_set( keys.begin(), keys.end() );
+
+    double const start = now_ns();
+    frozen_observer_set<Node> const frozen_set( keys );
+    double const build_ns = ( now_ns() - start ) / static_cast<double>( n );
+
+    long std_hits = 0, mix_hits = 0, frozen_hits = 0;
+
+    double const std_ns    = measure( std_set   , probes, reps, std_hits    );
+    double const mix_ns    = measure( mix_set   , probes, reps, mix_hits    );
+    double const frozen_ns = measure( frozen_set, probes, reps, frozen_hits );
+
+    bool const same = std_hits == mix_hits && std_hits == frozen_hits;
+
+    std::cout << std::fixed << std::setprecision(3) <<
+        std::setw(8)  << n <<
+        std::setw(16) << std_ns << std::setw(16) << mix_ns << std::setw(12) << frozen_ns <<
+        std::setprecision(1) << std::setw(12) << build_ns <<
+        ( same ? "" : "  (hits mismatch)" ) << "\n";
+
+    return same ? 0 : 1;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    long const reps = argc > 1 ? std::atol( argv[1] ) : default_reps;
+
+    std::cout <<
+        "frozen_observer_set benchmark: " << ( nsop_USES_STD_OBSERVER_PTR ? "std::experimental" : "nonstd" ) <<
+        "::observer_ptr, C++ " << nsop_CPLUSPLUS << ", " <<
+        lookups << " lookups x " << reps << " repetitions, best of " << best_of << "\n\n" <<
+        std::setw(8)  << "keys" <<
+        std::setw(16) << "std::hash [ns]" << std::setw(16) << "mixing [ns]" << std::setw(12) << "frozen [ns]" <<
+        std::setw(12) << "build [ns]" << "\n";
+
+    int failures = 0;
+
+    for ( std::size_t n : key_counts )
+        failures += run( n, reps );
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if 0
+g++ -std=c++11 -O2 -DNDEBUG -I../include -o observer-frozen.b.exe observer-frozen.b.cpp && observer-frozen.b.exe
+g++ -std=c++17 -O2 -DNDEBUG -I../include -o observer-frozen.b.exe observer-frozen.b.cpp && observer-frozen.b.exe
+
+cl -EHsc -O2 -DNDEBUG -I../include observer-frozen.b.cpp && observer-frozen.b.exe
+#endif
+
+// end of file
@@ -0,0 +1,200 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Benchmark: callbacks via nonstd::function_ref against std::function.
+//
+// A function that is not inlined into its callers calls a callback for each element of a
+// range, as a parser or a visitor does. Two cases are timed, per call: a callback that is
+// created once and called for all elements, and a callback that is created anew for each
+// range of 8 elements, capturing more state than fits the small-object buffer of
+// std::function, so that std::function allocates. The sums of the callbacks must agree; the
+// program fails if they do not.
+
+#include "nonstd/observer_function.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+using nonstd::function_ref;
+
+namespace {
+
+// Benchmark parameters, the number of repetitions can be given on the command line:
+
+const std::size_t value_count  = 65536;
+const std::size_t range_length = 8;
+const int         best_of      = 5;
+const long        default_reps = 200;
+
+// Prevent the optimizer from discarding a computation:
+
+#if defined(__GNUC__) || defined(__clang__)
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    __asm__ __volatile__( "" : : "r,m"( value ) : "memory" );
+}
+
+# define nsop_BENCH_NOINLINE  __attribute__((noinline))
+#else
+
+volatile long sink;
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    sink = static_cast<long>( sizeof( value ) );
+}
+
+# define nsop_BENCH_NOINLINE  __declspec(noinline)
+#endif
+
+// Wall-clock time in nanoseconds:
+
+double now_ns()
+{
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+// Call f( x ) for each element x of [first, last):
+
+template< class Callback >
+nsop_BENCH_NOINLINE void for_each_element( long const * first, long const * last, Callback const & f )
+{
+    for ( ; first != last; ++first )
+        f( *first );
+}
+
+// Time a run over all elements, yield the best time per call in nanoseconds:
+
+template< class Run >
+double measure( Run run, std::size_t calls, long reps, long & checksum )
+{
+    double best = 0;
+
+    for ( int r = 0; r < best_of; ++r )
+    {
+        long sum = 0;
+        double const start = now_ns();
+
+        for ( long rep = 0; rep < reps; ++rep )
+        {
+            sum += run();
+            do_not_optimize( sum );
+        }
+
+        double const elapsed = now_ns() - start;
+
+        if ( r == 0 || elapsed < best )
+            best = elapsed;
+
+        checksum = sum;
+    }
+    return best / ( static_cast<double>( reps ) * static_cast<double>( calls ) );
+}
+
+// One callback for all elements:
+
+template< class Callback >
+long reuse( std::vector< long > const & values )
+{
+    long sum = 0;
+    auto const lambda = [&sum]( long x ) { sum += x; };
+    Callback const f = lambda;
+
+    for_each_element( values.data(), values.data() + values.size(), f );
+
+    return sum;
+}
+
+// A new callback per range of 8 elements, capturing four words:
+
+template< class Callback >
+long recreate( std::vector< long > const & values )
+{
+    long sum = 0, count = 0, largest = 0;
+
+    for ( std::size_t i = 0; i < values.size(); i += range_length )
+    {
+        long const first = values[i];
+
+        for_each_element( &values[i], &values[i] + range_length, Callback( [&sum, &count, &largest, first]( long x )
+        {
+            sum += x - first;
+            ++count;
+            largest = std::max( largest, x );
+        } ) );
+    }
+    return sum + count + largest;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    long const reps = argc > 1 ? std::atol( argv[1] ) : default_reps;
+
+    typedef function_ref< void( long ) > ref_type;
+    typedef std::function< void( long ) > function_type;
+
+    std::vector< long > values( value_count );
+    unsigned long seed = 12345;
+
+    for ( long & x : values )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        x = static_cast<long>( ( seed >> 8 ) % 1000 );
+    }
+
+    std::cout <<
+        "function_ref benchmark: C++ " << nsop_CPLUSPLUS << ", " <<
+        value_count << " calls x " << reps << " repetitions, best of " << best_of << "\n\n" <<
+        std::left  << std::setw(32) << "callback" <<
+        std::right << std::setw(20) << "function_ref [ns]" << std::setw(22) << "std::function [ns]" << "\n";
+
+    int failures = 0;
+    long ref_sum = 0, function_sum = 0;
+
+    double const reuse_ref      = measure( [&]() { return reuse< ref_type      >( values ); }, value_count, reps, ref_sum );
+    double const reuse_function = measure( [&]() { return reuse< function_type >( values ); }, value_count, reps, function_sum );
+
+    failures += ref_sum != function_sum;
+
+    std::cout << std::fixed << std::setprecision(3) <<
+        std::left  << std::setw(32) << "created once" <<
+        std::right << std::setw(20) << reuse_ref << std::setw(22) << reuse_function <<
+        ( ref_sum == function_sum ? "" : "  (checksum mismatch)" ) << "\n";
+
+    double const recreate_ref      = measure( [&]() { return recreate< ref_type      >( values ); }, value_count, reps, ref_sum );
+    double const recreate_function = measure( [&]() { return recreate< function_type >( values ); }, value_count, reps, function_sum );
+
+    failures += ref_sum != function_sum;
+
+    std::cout <<
+        std::left  << std::setw(32) << "created per 8 calls, 4 captures" <<
+        std::right << std::setw(20) << recreate_ref << std::setw(22) << recreate_function <<
+        ( ref_sum == function_sum ? "" : "  (checksum mismatch)" ) << "\n";
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if 0
+g++ -std=c++11 -O2 -DNDEBUG -I../include -o observer-function.b.exe observer-function.b.cpp && observer-function.b.exe
+g++ -std=c++17 -O2 -DNDEBUG -I../include -o observer-function.b.exe observer-function.b.cpp && observer-function.b.exe
+
+cl -EHsc -O2 -DNDEBUG -I../include observer-function.b.cpp && observer-function.b.exe
+#endif
+
+// end of file
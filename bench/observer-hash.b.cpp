@@ -0,0 +1,309 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Benchmark: quality of std::hash< observer_ptr<T> > against nonstd::observer_hash.
+//
+// The keys are observers of consecutive objects of 8, 16 and 64 bytes alignment, as from an
+// array or a pool. For each hash, the distribution over a table of 2^n buckets is reported:
+// the fraction of buckets used (63% for uniformly distributed hashes) and the longest bucket,
+// and the average number of probes of a successful lookup in a linear-probing flat table at
+// load factor 1/2 (1.5 for uniformly distributed hashes). Lookup throughput is timed for
+// std::unordered_map and for the flat table. The results of all lookups must agree; the
+// program fails if they do not.
+
+#include "nonstd/observer_ptr.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <unordered_map>
+#include <vector>
+
+using nonstd::observer_ptr;
+using nonstd::observer_hash;
+
+namespace {
+
+// Benchmark parameters, the number of repetitions can be given on the command line:
+
+const std::size_t key_count    = 16384;     // power of two
+const int         best_of      = 5;
+const long        default_reps = 20;
+
+// Prevent the optimizer from discarding a computation:
+
+#if defined(__GNUC__) || defined(__clang__)
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    __asm__ __volatile__( "" : : "r,m"( value ) : "memory" );
+}
+#else
+
+volatile long sink;
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    sink = static_cast<long>( sizeof( value ) );
+}
+#endif
+
+// Wall-clock time in nanoseconds:
+
+double now_ns()
+{
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+
+// The observed objects, of the given alignment:
+
+template< std::size_t Align >
+struct alignas(Align) Node
+{
+    long value;
+};
+
+// Flat table: open addressing with linear probing over 2^n slots, a null key marks an empty slot:
+
+template< class T, class Hash >
+class flat_table
+{
+public:
+    explicit flat_table( std::size_t capacity )
+    : slots( capacity ), mask( capacity - 1 ) {}
+
+    void insert( observer_ptr<T> key, long value )
+    {
+        std::size_t i = Hash()( key ) & mask;
+
+        while ( slots[i].key )
+            i = ( i + 1 ) & mask;
+
+        slots[i].key   = key;
+        slots[i].value = value;
+    }
+
+    long find( observer_ptr<T> key ) const
+    {
+        for ( std::size_t i = Hash()( key ) & mask; slots[i].key; i = ( i + 1 ) & mask )
+        {
+            if ( slots[i].key == key )
+                return slots[i].value;
+        }
+        return -1;
+    }
+
+    std::size_t probes( observer_ptr<T> key ) const
+    {
+        std::size_t count = 1;
+
+        for ( std::size_t i = Hash()( key ) & mask; slots[i].key != key; i = ( i + 1 ) & mask )
+            ++count;
+
+        return count;
+    }
+
+private:
+    struct slot
+    {
+        observer_ptr<T> key;
+        long value;
+    };
+
+    std::vector< slot > slots;
+    std::size_t mask;
+};
+
+struct Result
+{
+    char const * name;
+    double used_buckets;
+    std::size_t longest_bucket;
+    double probes;
+    double map_ns;
+    double flat_ns;
+    long checksum;
+};
+
+// Time lookups of all keys, yield the best time per lookup in nanoseconds:
+
+template< class Find >
+double measure( Find find, std::size_t n, long reps, long & checksum )
+{
+    double best = 0;
+
+    for ( int run = 0; run < best_of; ++run )
+    {
+        long sum = 0;
+        double const start = now_ns();
+
+        for ( long rep = 0; rep < reps; ++rep )
+        {
+            sum += find();
+            do_not_optimize( sum );
+        }
+
+        double const elapsed = now_ns() - start;
+
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+
+        checksum = sum;
+    }
+    return best / ( static_cast<double>( reps ) * static_cast<double>( n ) );
+}
+
+template< class T, class Hash >
+Result run( char const * name, std::vector<T> & nodes, std::vector< observer_ptr<T> > const & order, long reps )
+{
+    std::size_t const n = nodes.size();
+
+    Result result;
+    result.name = name;
+
+    // distribution over n buckets:
+
+    std::vector< std::size_t > buckets( n );
+
+    for ( T & node : nodes )
+        ++buckets[ Hash()( nonstd::make_observer( &node ) ) & ( n - 1 ) ];
+
+    result.used_buckets   = static_cast<double>( n - static_cast<std::size_t>( std::count( buckets.begin(), buckets.end(), 0u ) ) ) / static_cast<double>( n );
+    result.longest_bucket = *std::max_element( buckets.begin(), buckets.end() );
+
+    // tables:
+
+    std::unordered_map< observer_ptr<T>, long, Hash > map;
+    flat_table< T, Hash > flat( 2 * n );
+
+    for ( T & node : nodes )
+    {
+        observer_ptr<T> const key = nonstd::make_observer( &node );
+
+        map[ key ] = node.value;
+        flat.insert( key, node.value );
+    }
+
+    std::size_t probes = 0;
+
+    for ( observer_ptr<T> key : order )
+        probes += flat.probes( key );
+
+    result.probes = static_cast<double>( probes ) / static_cast<double>( n );
+
+    // lookups in pseudo-random order:
+
+    long map_sum = 0, flat_sum = 0;
+
+    result.map_ns = measure( [&]()
+    {
+        long sum = 0;
+        for ( observer_ptr<T> key : order )
+            sum += map.find( key )->second;
+        return sum;
+    }, n, reps, map_sum );
+
+    result.flat_ns = measure( [&]()
+    {
+        long sum = 0;
+        for ( observer_ptr<T> key : order )
+            sum += flat.find( key );
+        return sum;
+    }, n, reps, flat_sum );
+
+    result.checksum = map_sum == flat_sum ? map_sum : -1;
+
+    return result;
+}
+
+// Run both hashes for objects of the given alignment and report:
+
+template< std::size_t Align >
+int run_alignment( long reps )
+{
+    typedef Node<Align> T;
+
+    std::vector<T> nodes( key_count );
+    std::vector< observer_ptr<T> > order( key_count );
+    unsigned long seed = 12345;
+
+    for ( std::size_t i = 0; i < key_count; ++i )
+    {
+        nodes[i].value = static_cast<long>( i );
+        order[i]       = nonstd::make_observer( &nodes[i] );
+    }
+
+    for ( std::size_t i = key_count - 1; i > 0; --i )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        std::swap( order[i], order[ ( seed >> 8 ) % ( i + 1 ) ] );
+    }
+
+    Result const results[] =
+    {
+        run< T, std::hash< observer_ptr<T> > >( "std::hash"    , nodes, order, reps ),
+        run< T, observer_hash                >( "observer_hash", nodes, order, reps ),
+    };
+
+    int failures = 0;
+
+    for ( std::size_t i = 0; i < sizeof( results ) / sizeof( results[0] ); ++i )
+    {
+        Result const & r = results[i];
+
+        std::cout << std::fixed <<
+            std::right << std::setw(5)  << Align << "  " <<
+            std::left  << std::setw(15) << r.name <<
+            std::right << std::setprecision(1) << std::setw(12) << 100 * r.used_buckets << "%" <<
+            std::setw(9)  << r.longest_bucket <<
+            std::setw(10) << r.probes <<
+            std::setprecision(3) << std::setw(14) << r.map_ns << std::setw(14) << r.flat_ns <<
+            ( r.checksum == results[0].checksum && r.checksum != -1 ? "" : "  (checksum mismatch)" ) << "\n";
+
+        failures += !( r.checksum == results[0].checksum && r.checksum != -1 );
+    }
+    return failures;
+}
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    long const reps = argc > 1 ? std::atol( argv[1] ) : default_reps;
+
+    std::cout <<
+        "observer_ptr hash benchmark: " << ( nsop_USES_STD_OBSERVER_PTR ? "std::experimental" : "nonstd" ) <<
+        "::observer_ptr, C++ " << nsop_CPLUSPLUS << ", nsop_CONFIG_MIXING_HASH=" << nsop_CONFIG_MIXING_HASH << ", " <<
+        key_count << " keys x " << reps << " repetitions, best of " << best_of << "\n\n" <<
+        std::right << std::setw(5) << "align" << "  " <<
+        std::left  << std::setw(15) << "hash" <<
+        std::right << std::setw(13) << "used buckets" << std::setw(9) << "longest" << std::setw(10) << "probes" <<
+        std::setw(14) << "map [ns]" << std::setw(14) << "flat [ns]" << "\n";
+
+    int failures = 0;
+
+    failures += run_alignment<  8 >( reps );
+    failures += run_alignment< 16 >( reps );
+    failures += run_alignment< 64 >( reps );
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if 0
+g++ -std=c++11 -O2 -DNDEBUG -I../include -o observer-hash.b.exe observer-hash.b.cpp && observer-hash.b.exe
+g++ -std=c++17 -O2 -DNDEBUG -I../include -o observer-hash.b.exe observer-hash.b.cpp && observer-hash.b.exe
+
+cl -EHsc -O2 -DNDEBUG -I../include observer-hash.b.cpp && observer-hash.b.exe
+#endif
+
+// end of file
@@ -0,0 +1,333 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Benchmark: time the operations of observer_ptr<T> against the same operations on T*.
+//
+// Each operation is applied to an array of pointers that fits in the L1 cache, so that
+// the instructions generated for the operation, not memory latency, dominate the timing.
+// The checksums of both variants must agree; the program fails if they do not.
+
+#include "nonstd/observer_ptr.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <vector>
+
+#if nsop_CPP11_OR_GREATER
+# include <chrono>
+#else
+# include <ctime>
+#endif
+
+using nonstd::observer_ptr;
+
+namespace {
+
+// Benchmark parameters, the number of repetitions can be given on the command line:
+
+const std::size_t element_count = 4096;
+const int         best_of       = 5;
+const long        default_reps  = 20000;
+
+// Prevent the optimizer from discarding a computation or hoisting it out of a loop:
+
+#if defined(__GNUC__) || defined(__clang__)
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    __asm__ __volatile__( "" : : "r,m"( value ) : "memory" );
+}
+
+inline void clobber_memory()
+{
+    __asm__ __volatile__( "" : : : "memory" );
+}
+#else
+
+volatile long sink;
+
+template< class T >
+inline void do_not_optimize( T const & value )
+{
+    sink = static_cast<long>( sizeof( value ) );
+}
+
+inline void clobber_memory()
+{
+    sink = 0;
+}
+#endif
+
+// Wall-clock time in nanoseconds:
+
+#if nsop_CPP11_OR_GREATER
+
+double now_ns()
+{
+    return static_cast<double>( std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch() ).count() );
+}
+#else
+
+double now_ns()
+{
+    return 1e9 * static_cast<double>( std::clock() ) / CLOCKS_PER_SEC;
+}
+#endif
+
+// The observed object:
+
+struct Node
+{
+    Node() : value( 0 ) {}
+    long value;
+};
+
+// Operations that are spelled differently for T* and observer_ptr<T>:
+
+inline Node * get_( Node * p ) { return p; }
+inline Node * get_( observer_ptr<Node> p ) { return p.get(); }
+
+inline void reset_( Node * & p, Node * q ) { p = q; }
+inline void reset_( observer_ptr<Node> & p, Node * q ) { p.reset( q ); }
+
+inline Node * release_( Node * & p ) { Node * q = p; p = 0; return q; }
+inline Node * release_( observer_ptr<Node> & p ) { return p.release(); }
+
+inline bool less_( Node * p, Node * q ) { return std::less<Node *>()( p, q ); }
+inline bool less_( observer_ptr<Node> p, observer_ptr<Node> q ) { return p < q; }
+
+inline bool less_equal_( Node * p, Node * q ) { return !std::less<Node *>()( q, p ); }
+inline bool less_equal_( observer_ptr<Node> p, observer_ptr<Node> q ) { return p <= q; }
+
+inline bool greater_( Node * p, Node * q ) { return std::less<Node *>()( q, p ); }
+inline bool greater_( observer_ptr<Node> p, observer_ptr<Node> q ) { return p > q; }
+
+inline bool greater_equal_( Node * p, Node * q ) { return !std::less<Node *>()( p, q ); }
+inline bool greater_equal_( observer_ptr<Node> p, observer_ptr<Node> q ) { return p >= q; }
+
+// Kernels, identical for T* and observer_ptr<T>; ptrs[n..2n) is scratch space:
+
+template< class P >
+long kernel_get( P * ptrs, std::size_t n )
+{
+    long sum = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+        sum += get_( ptrs[i] )->value;
+    return sum;
+}
+
+template< class P >
+long kernel_deref( P * ptrs, std::size_t n )
+{
+    long sum = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+        sum += (*ptrs[i]).value;
+    return sum;
+}
+
+template< class P >
+long kernel_arrow( P * ptrs, std::size_t n )
+{
+    long sum = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+        sum += ptrs[i]->value;
+    return sum;
+}
+
+template< class P >
+long kernel_bool( P * ptrs, std::size_t n )
+{
+    long count = 0;
+    for ( std::size_t i = 0; i < n; ++i )
+        if ( ptrs[n + i] )
+            ++count;
+    return count;
+}
+
+template< class P >
+long kernel_swap( P * ptrs, std::size_t n )
+{
+    using std::swap;
+    for ( std::size_t i = 0; i < n / 2; ++i )
+        swap( ptrs[i], ptrs[n - 1 - i] );
+    return get_( ptrs[0] )->value;
+}
+
+template< class P >
+long kernel_reset_release( P * ptrs, std::size_t n )
+{
+    for ( std::size_t i = 0; i < n; ++i )
+        reset_( ptrs[n + i], release_( ptrs[i] ) );
+    for ( std::size_t i = 0; i < n; ++i )
+        reset_( ptrs[i], release_( ptrs[n + i] ) );
+    return get_( ptrs[n - 1] )->value;
+}
+
+template< class P >
+long kernel_equal( P * ptrs, std::size_t n )
+{
+    long count = 0;
+    for ( std::size_t i = 1; i < n; ++i )
+        count += ( ptrs[i - 1] == ptrs[i] ) + 2 * ( ptrs[i] != ptrs[n - i] );
+    return count;
+}
+
+template< class P >
+long kernel_order( P * ptrs, std::size_t n )
+{
+    long count = 0;
+    for ( std::size_t i = 1; i < n; ++i )
+        count += less_( ptrs[i - 1], ptrs[i] ) + 2 * less_equal_( ptrs[i - 1], ptrs[i] )
+            + 4 * greater_( ptrs[i - 1], ptrs[i] ) + 8 * greater_equal_( ptrs[i - 1], ptrs[i] );
+    return count;
+}
+
+// Time a kernel, yield the best time per element in nanoseconds:
+
+template< class P >
+double measure( long (*kernel)( P *, std::size_t ), P * ptrs, std::size_t n, long reps, long & checksum )
+{
+    double best = 0;
+
+    for ( int run = 0; run < best_of; ++run )
+    {
+        long sum = 0;
+        double const start = now_ns();
+
+        for ( long rep = 0; rep < reps; ++rep )
+        {
+            sum += kernel( ptrs, n );
+            do_not_optimize( sum );
+            clobber_memory();
+        }
+
+        double const elapsed = now_ns() - start;
+
+        if ( run == 0 || elapsed < best )
+            best = elapsed;
+
+        checksum = sum;
+    }
+    return best / ( static_cast<double>( reps ) * static_cast<double>( n ) );
+}
+
+// Fill raw and observer arrays identically: [0..n) in pseudo-random order, [n..2n) with every third null:
+
+void fill( std::vector<Node> & nodes, std::vector<Node *> & raws, std::vector< observer_ptr<Node> > & observers )
+{
+    std::size_t const n = nodes.size();
+    unsigned long seed = 12345;
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        nodes[i].value = static_cast<long>( i );
+        raws[i]        = &nodes[i];
+    }
+
+    for ( std::size_t i = n - 1; i > 0; --i )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        std::swap( raws[i], raws[ ( seed >> 8 ) % ( i + 1 ) ] );
+    }
+
+    for ( std::size_t i = 0; i < n; ++i )
+    {
+        raws[n + i] = i % 3 == 0 ? static_cast<Node *>( 0 ) : raws[i];
+    }
+
+    for ( std::size_t i = 0; i < 2 * n; ++i )
+    {
+        observers[i] = nonstd::make_observer( raws[i] );
+    }
+}
+
+struct Result
+{
+    char const * name;
+    double raw_ns;
+    double observer_ns;
+    bool   same;
+};
+
+template< class K1, class K2 >
+Result run( char const * name, K1 raw_kernel, K2 observer_kernel, std::size_t n, long reps )
+{
+    std::vector<Node> nodes( n );
+    std::vector<Node *> raws( 2 * n );
+    std::vector< observer_ptr<Node> > observers( 2 * n );
+
+    fill( nodes, raws, observers );
+
+    long raw_sum = 0, observer_sum = 0;
+
+    Result result;
+    result.name        = name;
+    result.raw_ns      = measure( raw_kernel     , &raws[0]     , n, reps, raw_sum      );
+    result.observer_ns = measure( observer_kernel, &observers[0], n, reps, observer_sum );
+    result.same        = raw_sum == observer_sum;
+
+    return result;
+}
+
+#define nsop_BENCH( name, kernel ) \
+    run( name, &kernel<Node *>, &kernel< observer_ptr<Node> >, element_count, reps )
+
+} // anonymous namespace
+
+int main( int argc, char * argv[] )
+{
+    long const reps = argc > 1 ? std::atol( argv[1] ) : default_reps;
+
+    Result const results[] =
+    {
+        nsop_BENCH( "get()"               , kernel_get           ),
+        nsop_BENCH( "operator*()"         , kernel_deref         ),
+        nsop_BENCH( "operator->()"        , kernel_arrow         ),
+        nsop_BENCH( "operator bool()"     , kernel_bool          ),
+        nsop_BENCH( "swap()"              , kernel_swap          ),
+        nsop_BENCH( "reset(release())"    , kernel_reset_release ),
+        nsop_BENCH( "operator==, !="      , kernel_equal         ),
+        nsop_BENCH( "operator<, <=, >, >=", kernel_order         ),
+    };
+
+    std::cout <<
+        "observer_ptr benchmark: " << ( nsop_USES_STD_OBSERVER_PTR ? "std::experimental" : "nonstd" ) <<
+        "::observer_ptr, C++ " << nsop_CPLUSPLUS << ", " <<
+        element_count << " elements x " << reps << " repetitions, best of " << best_of << "\n\n" <<
+        std::left  << std::setw(22) << "operation" <<
+        std::right << std::setw(12) << "T* [ns]" << std::setw(22) << "observer_ptr [ns]" << std::setw(10) << "ratio" << "\n";
+
+    int failures = 0;
+
+    for ( std::size_t i = 0; i < sizeof( results ) / sizeof( results[0] ); ++i )
+    {
+        Result const & r = results[i];
+
+        std::cout << std::fixed << std::setprecision(3) <<
+            std::left  << std::setw(22) << r.name <<
+            std::right << std::setw(12) << r.raw_ns << std::setw(22) << r.observer_ns <<
+            std::setw(10) << ( r.raw_ns > 0 ? r.observer_ns / r.raw_ns : 0 ) <<
+            ( r.same ? "" : "  (checksum mismatch)" ) << "\n";
+
+        failures += !r.same;
+    }
+
+    return failures == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#if 0
+g++ -std=c++98 -O2 -DNDEBUG -I../include -o observer-ptr.b.exe observer-ptr.b.cpp && observer-ptr.b.exe
+g++ -std=c++17 -O2 -DNDEBUG -I../include -o observer-ptr.b.exe observer-ptr.b.cpp && observer-ptr.b.exe
+
+cl -EHsc -O2 -DNDEBUG -I../include observer-ptr.b.cpp && observer-ptr.b.exe
+#endif
+
+// end of file
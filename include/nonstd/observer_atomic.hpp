@@ -0,0 +1,332 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::atomic_observer_ptr<> and nonstd::atomic_observer_ref<>: lock-free atomic observers, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_ATOMIC_H_INCLUDED
+#define NONSTD_OBSERVER_ATOMIC_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+// Presence of atomic operations on an existing object:
+// - C++20 std::atomic_ref,
+// - GNU and Clang __atomic builtins.
+
+#if defined( __cpp_lib_atomic_ref ) || ( nsop_CPP20_OR_GREATER && nsop_COMPILER_MSVC_VER >= 1928 )
+# define nsop_HAVE_STD_ATOMIC_REF  1
+#else
+# define nsop_HAVE_STD_ATOMIC_REF  0
+#endif
+
+#define nsop_HAVE_ATOMIC_BUILTINS  ( nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION )
+
+#define nsop_HAVE_ATOMIC_OBSERVER_REF  ( nsop_HAVE_STD_ATOMIC_REF || nsop_HAVE_ATOMIC_BUILTINS )
+
+namespace nonstd { namespace observer_ptr_lite {
+
+// atomic_observer_ptr: an observer that is loaded, stored, exchanged and compared-and-exchanged
+// atomically. It is always lock-free; it does not compile where std::atomic<T*> is not.
+
+template< class W >
+class atomic_observer_ptr
+{
+public:
+    typedef observer_ptr<W> value_type;
+    typedef W * pointer;
+
+    static_assert( ATOMIC_POINTER_LOCK_FREE == 2, "atomic_observer_ptr: requires an always lock-free std::atomic<T*>" );
+
+    static constexpr bool is_always_lock_free = true;
+
+    nsop_constexpr atomic_observer_ptr() nsop_noexcept
+    : ptr( nsop_NULLPTR ) {}
+
+    nsop_constexpr explicit atomic_observer_ptr( pointer p ) nsop_noexcept
+    : ptr( p ) {}
+
+    atomic_observer_ptr( value_type p ) nsop_noexcept
+    : ptr( p.get() ) {}
+
+    atomic_observer_ptr( atomic_observer_ptr const & ) = delete;
+    atomic_observer_ptr & operator=( atomic_observer_ptr const & ) = delete;
+
+    value_type operator=( value_type p ) nsop_noexcept
+    {
+        store( p );
+        return p;
+    }
+
+    bool is_lock_free() const nsop_noexcept
+    {
+        return true;
+    }
+
+    void store( value_type p, std::memory_order order = std::memory_order_seq_cst ) nsop_noexcept
+    {
+        ptr.store( p.get(), order );
+    }
+
+    value_type load( std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return value_type( ptr.load( order ) );
+    }
+
+    operator value_type() const nsop_noexcept
+    {
+        return load();
+    }
+
+    value_type exchange( value_type p, std::memory_order order = std::memory_order_seq_cst ) nsop_noexcept
+    {
+        return value_type( ptr.exchange( p.get(), order ) );
+    }
+
+    bool compare_exchange_weak( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ptr.compare_exchange_weak( e, desired.get(), success, failure );
+        expected.reset( e );
+        return result;
+    }
+
+    bool compare_exchange_weak( value_type & expected, value_type desired, std::memory_order order = std::memory_order_seq_cst ) nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ptr.compare_exchange_weak( e, desired.get(), order );
+        expected.reset( e );
+        return result;
+    }
+
+    bool compare_exchange_strong( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ptr.compare_exchange_strong( e, desired.get(), success, failure );
+        expected.reset( e );
+        return result;
+    }
+
+    bool compare_exchange_strong( value_type & expected, value_type desired, std::memory_order order = std::memory_order_seq_cst ) nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ptr.compare_exchange_strong( e, desired.get(), order );
+        expected.reset( e );
+        return result;
+    }
+
+#if nsop_CPP20_OR_GREATER && defined( __cpp_lib_atomic_wait )
+    void wait( value_type old, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        ptr.wait( old.get(), order );
+    }
+
+    void notify_one() nsop_noexcept
+    {
+        ptr.notify_one();
+    }
+
+    void notify_all() nsop_noexcept
+    {
+        ptr.notify_all();
+    }
+#endif
+
+private:
+    std::atomic<pointer> ptr;
+};
+
+template< class W > constexpr bool atomic_observer_ptr<W>::is_always_lock_free;
+
+#if nsop_HAVE_ATOMIC_OBSERVER_REF
+
+namespace detail
+{
+#if !nsop_HAVE_STD_ATOMIC_REF
+    inline constexpr int to_atomic_builtin( std::memory_order order ) nsop_noexcept
+    {
+        return order == std::memory_order_relaxed ? __ATOMIC_RELAXED
+             : order == std::memory_order_consume ? __ATOMIC_CONSUME
+             : order == std::memory_order_acquire ? __ATOMIC_ACQUIRE
+             : order == std::memory_order_release ? __ATOMIC_RELEASE
+             : order == std::memory_order_acq_rel ? __ATOMIC_ACQ_REL
+             :                                      __ATOMIC_SEQ_CST;
+    }
+#endif
+
+    // failure order may not be release or acq_rel:
+
+    inline constexpr std::memory_order to_failure_order( std::memory_order order ) nsop_noexcept
+    {
+        return order == std::memory_order_acq_rel ? std::memory_order_acquire
+             : order == std::memory_order_release ? std::memory_order_relaxed
+             : order;
+    }
+} // namespace detail
+
+// atomic_observer_ref: atomic operations on an observer_ptr that is part of an existing object,
+// like std::atomic_ref. While an atomic_observer_ref to an observer exists, the observer must
+// only be accessed via atomic_observer_refs. Lock-free.
+
+template< class W >
+class atomic_observer_ref
+{
+public:
+    typedef observer_ptr<W> value_type;
+    typedef W * pointer;
+
+    static_assert( sizeof( value_type ) == sizeof( pointer ) && std::is_standard_layout<value_type>::value,
+        "atomic_observer_ref: observer_ptr must be layout-compatible with a pointer" );
+
+    static constexpr bool is_always_lock_free = true;
+    static constexpr std::size_t required_alignment = alignof( pointer );
+
+    explicit atomic_observer_ref( value_type & obj ) nsop_noexcept
+    : ptr( reinterpret_cast<pointer *>( &obj ) )
+    {
+        assert( reinterpret_cast<std::uintptr_t>( ptr ) % required_alignment == 0 );
+    }
+
+    atomic_observer_ref( atomic_observer_ref const & ) nsop_noexcept = default;
+    atomic_observer_ref & operator=( atomic_observer_ref const & ) = delete;
+
+    value_type operator=( value_type p ) const nsop_noexcept
+    {
+        store( p );
+        return p;
+    }
+
+    bool is_lock_free() const nsop_noexcept
+    {
+        return true;
+    }
+
+    operator value_type() const nsop_noexcept
+    {
+        return load();
+    }
+
+#if nsop_HAVE_STD_ATOMIC_REF
+    void store( value_type p, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        ref().store( p.get(), order );
+    }
+
+    value_type load( std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return value_type( ref().load( order ) );
+    }
+
+    value_type exchange( value_type p, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return value_type( ref().exchange( p.get(), order ) );
+    }
+
+    bool compare_exchange_weak( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) const nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ref().compare_exchange_weak( e, desired.get(), success, failure );
+        expected.reset( e );
+        return result;
+    }
+
+    bool compare_exchange_strong( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) const nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = ref().compare_exchange_strong( e, desired.get(), success, failure );
+        expected.reset( e );
+        return result;
+    }
+#else
+    void store( value_type p, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        __atomic_store_n( ptr, p.get(), detail::to_atomic_builtin( order ) );
+    }
+
+    value_type load( std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return value_type( __atomic_load_n( ptr, detail::to_atomic_builtin( order ) ) );
+    }
+
+    value_type exchange( value_type p, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return value_type( __atomic_exchange_n( ptr, p.get(), detail::to_atomic_builtin( order ) ) );
+    }
+
+    bool compare_exchange_weak( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) const nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = __atomic_compare_exchange_n( ptr, &e, desired.get(), true, detail::to_atomic_builtin( success ), detail::to_atomic_builtin( failure ) );
+        expected.reset( e );
+        return result;
+    }
+
+    bool compare_exchange_strong( value_type & expected, value_type desired, std::memory_order success, std::memory_order failure ) const nsop_noexcept
+    {
+        pointer e = expected.get();
+        bool const result = __atomic_compare_exchange_n( ptr, &e, desired.get(), false, detail::to_atomic_builtin( success ), detail::to_atomic_builtin( failure ) );
+        expected.reset( e );
+        return result;
+    }
+#endif
+
+    bool compare_exchange_weak( value_type & expected, value_type desired, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return compare_exchange_weak( expected, desired, order, detail::to_failure_order( order ) );
+    }
+
+    bool compare_exchange_strong( value_type & expected, value_type desired, std::memory_order order = std::memory_order_seq_cst ) const nsop_noexcept
+    {
+        return compare_exchange_strong( expected, desired, order, detail::to_failure_order( order ) );
+    }
+
+private:
+#if nsop_HAVE_STD_ATOMIC_REF
+    std::atomic_ref<pointer> ref() const nsop_noexcept
+    {
+        return std::atomic_ref<pointer>( *ptr );
+    }
+#endif
+
+    pointer * ptr;
+};
+
+template< class W > constexpr bool atomic_observer_ref<W>::is_always_lock_free;
+template< class W > constexpr std::size_t atomic_observer_ref<W>::required_alignment;
+
+template< class W >
+atomic_observer_ref<W> make_atomic_observer_ref( observer_ptr<W> & obj ) nsop_noexcept
+{
+    return atomic_observer_ref<W>( obj );
+}
+
+#endif // nsop_HAVE_ATOMIC_OBSERVER_REF
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::atomic_observer_ptr;
+
+#if nsop_HAVE_ATOMIC_OBSERVER_REF
+using observer_ptr_lite::atomic_observer_ref;
+using observer_ptr_lite::make_atomic_observer_ref;
+#endif
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_ATOMIC_H_INCLUDED
+
+// end of file
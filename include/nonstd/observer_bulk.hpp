@@ -0,0 +1,358 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::count_nonnull() etc.: vectorized algorithms over arrays of observer_ptrs, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_BULK_H_INCLUDED
+#define NONSTD_OBSERVER_BULK_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#define nsop_SIMD_NONE    0
+#define nsop_SIMD_SSE2    1
+#define nsop_SIMD_AVX2    2
+#define nsop_SIMD_AVX512  3
+
+// Instruction set for the algorithms, at default the widest one the compiler targets
+// on x86-64 with GNU or Clang:
+
+#ifndef nsop_CONFIG_SIMD
+# if ( nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION ) && defined(__x86_64__) && !defined(__ILP32__)
+#  if   defined(__AVX512F__)
+#   define nsop_CONFIG_SIMD  nsop_SIMD_AVX512
+#  elif defined(__AVX2__)
+#   define nsop_CONFIG_SIMD  nsop_SIMD_AVX2
+#  elif defined(__SSE2__)
+#   define nsop_CONFIG_SIMD  nsop_SIMD_SSE2
+#  endif
+# endif
+#endif
+
+#ifndef nsop_CONFIG_SIMD
+# define nsop_CONFIG_SIMD  nsop_SIMD_NONE
+#endif
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+# include <immintrin.h>
+#endif
+
+// The code that depends on the instruction set is in an inline namespace per instruction set,
+// so that translation units compiled for different ones do not share functions of the same
+// name and the linker cannot pick a version the processor lacks:
+
+#if   nsop_CONFIG_SIMD == nsop_SIMD_AVX512
+# define nsop_SIMD_NAMESPACE  simd_avx512
+#elif nsop_CONFIG_SIMD == nsop_SIMD_AVX2
+# define nsop_SIMD_NAMESPACE  simd_avx2
+#elif nsop_CONFIG_SIMD == nsop_SIMD_SSE2
+# define nsop_SIMD_NAMESPACE  simd_sse2
+#else
+# define nsop_SIMD_NAMESPACE  simd_none
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    template< class T >
+    struct identity { typedef T type; };
+
+    // The algorithms access an array of observers as an array of pointers:
+
+    template< class T >
+    inline void require_pointer_layout() nsop_noexcept
+    {
+        static_assert( sizeof( observer_ptr<T> ) == sizeof( T * ), "observer_ptr<T>: expected the size of T*" );
+        static_assert( std::is_trivially_copyable< observer_ptr<T> >::value, "observer_ptr<T>: expected to be trivially copyable" );
+    }
+} // namespace detail
+
+namespace detail { inline namespace nsop_SIMD_NAMESPACE {
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+
+    // Vectors of pointers; the mask has one bit per pointer, set if it is equal:
+
+    inline unsigned popcount( unsigned m ) nsop_noexcept { return static_cast<unsigned>( __builtin_popcount( m ) ); }
+    inline unsigned lowest_bit( unsigned m ) nsop_noexcept { return static_cast<unsigned>( __builtin_ctz( m ) ); }
+
+# if   nsop_CONFIG_SIMD == nsop_SIMD_AVX512
+
+    typedef __m512i vec;
+
+    std::size_t const lanes = 8;
+
+    inline vec load( void const * p ) nsop_noexcept { return _mm512_loadu_si512( p ); }
+    inline vec splat( std::uintptr_t a ) nsop_noexcept { return _mm512_set1_epi64( static_cast<long long>( a ) ); }
+    inline unsigned equal( vec a, vec b ) nsop_noexcept { return _mm512_cmpeq_epi64_mask( a, b ); }
+
+    // Store the pointers of v for which m has a bit set to p, in order:
+
+    inline void compress_store( void * p, unsigned m, vec v ) nsop_noexcept
+    {
+        _mm512_mask_compressstoreu_epi64( p, static_cast<__mmask8>( m ), v );
+    }
+
+# elif nsop_CONFIG_SIMD == nsop_SIMD_AVX2
+
+    typedef __m256i vec;
+
+    std::size_t const lanes = 4;
+
+    inline vec load( void const * p ) nsop_noexcept { return _mm256_loadu_si256( static_cast<vec const *>( p ) ); }
+    inline vec splat( std::uintptr_t a ) nsop_noexcept { return _mm256_set1_epi64x( static_cast<long long>( a ) ); }
+    inline unsigned equal( vec a, vec b ) nsop_noexcept
+    {
+        return static_cast<unsigned>( _mm256_movemask_pd( _mm256_castsi256_pd( _mm256_cmpeq_epi64( a, b ) ) ) );
+    }
+
+    // Store the pointers of v for which m has a bit set to p, in order; writes all lanes:
+
+    inline void compress_store( void * p, unsigned m, vec v ) nsop_noexcept
+    {
+        alignas(32) static const std::int32_t permutation[16][8] =
+        {
+            { 0, 0, 0, 0, 0, 0, 0, 0 },
+            { 0, 1, 0, 0, 0, 0, 0, 0 },
+            { 2, 3, 0, 0, 0, 0, 0, 0 },
+            { 0, 1, 2, 3, 0, 0, 0, 0 },
+            { 4, 5, 0, 0, 0, 0, 0, 0 },
+            { 0, 1, 4, 5, 0, 0, 0, 0 },
+            { 2, 3, 4, 5, 0, 0, 0, 0 },
+            { 0, 1, 2, 3, 4, 5, 0, 0 },
+            { 6, 7, 0, 0, 0, 0, 0, 0 },
+            { 0, 1, 6, 7, 0, 0, 0, 0 },
+            { 2, 3, 6, 7, 0, 0, 0, 0 },
+            { 0, 1, 2, 3, 6, 7, 0, 0 },
+            { 4, 5, 6, 7, 0, 0, 0, 0 },
+            { 0, 1, 4, 5, 6, 7, 0, 0 },
+            { 2, 3, 4, 5, 6, 7, 0, 0 },
+            { 0, 1, 2, 3, 4, 5, 6, 7 },
+        };
+
+        vec const index = _mm256_load_si256( reinterpret_cast<vec const *>( permutation[ m ] ) );
+        _mm256_storeu_si256( static_cast<vec *>( p ), _mm256_permutevar8x32_epi32( v, index ) );
+    }
+
+# elif nsop_CONFIG_SIMD == nsop_SIMD_SSE2
+
+    typedef __m128i vec;
+
+    std::size_t const lanes = 2;
+
+    inline vec load( void const * p ) nsop_noexcept { return _mm_loadu_si128( static_cast<vec const *>( p ) ); }
+    inline vec splat( std::uintptr_t a ) nsop_noexcept { return _mm_set1_epi64x( static_cast<long long>( a ) ); }
+
+    // SSE2 compares 32-bit halves; a pointer is equal if both its halves are:
+
+    inline unsigned equal( vec a, vec b ) nsop_noexcept
+    {
+        vec const half = _mm_cmpeq_epi32( a, b );
+        vec const both = _mm_and_si128( half, _mm_shuffle_epi32( half, _MM_SHUFFLE( 2, 3, 0, 1 ) ) );
+        return static_cast<unsigned>( _mm_movemask_pd( _mm_castsi128_pd( both ) ) );
+    }
+# endif
+
+    unsigned const all_lanes = ( 1u << lanes ) - 1;
+
+#endif // nsop_CONFIG_SIMD
+
+    // Index of the first observer in [first, first + n) equal to address a, n if none:
+
+    template< class T >
+    std::size_t find_address( observer_ptr<T> const * first, std::size_t n, std::uintptr_t a ) nsop_noexcept
+    {
+        std::size_t i = 0;
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+        vec const value = splat( a );
+
+        for ( ; i + lanes <= n; i += lanes )
+        {
+            unsigned const m = equal( load( first + i ), value );
+
+            if ( m != 0 )
+                return i + lowest_bit( m );
+        }
+#endif
+        for ( ; i != n && address_of( first[i] ) != a; ++i ) {}
+
+        return i;
+    }
+
+    // Number of observers in [first, first + n) equal to address a:
+
+    template< class T >
+    std::size_t count_address( observer_ptr<T> const * first, std::size_t n, std::uintptr_t a ) nsop_noexcept
+    {
+        std::size_t i = 0;
+        std::size_t count = 0;
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+        vec const value = splat( a );
+
+        for ( ; i + lanes <= n; i += lanes )
+        {
+            count += popcount( equal( load( first + i ), value ) );
+        }
+#endif
+        for ( ; i != n; ++i )
+        {
+            count += address_of( first[i] ) == a;
+        }
+        return count;
+    }
+
+    // Whether all observers in [first, first + n) are equal to address a:
+
+    template< class T >
+    bool all_address( observer_ptr<T> const * first, std::size_t n, std::uintptr_t a ) nsop_noexcept
+    {
+        std::size_t i = 0;
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+        vec const value = splat( a );
+
+        for ( ; i + lanes <= n; i += lanes )
+        {
+            if ( equal( load( first + i ), value ) != all_lanes )
+                return false;
+        }
+#endif
+        for ( ; i != n; ++i )
+        {
+            if ( address_of( first[i] ) != a )
+                return false;
+        }
+        return true;
+    }
+} // namespace nsop_SIMD_NAMESPACE
+} // namespace detail
+
+// Vectorized algorithms over contiguous arrays [first, last) of observer_ptrs. They use
+// SSE2, AVX2 or AVX-512, per nsop_CONFIG_SIMD, and scalar code for the remainder.
+
+inline namespace nsop_SIMD_NAMESPACE {
+
+// count_nonnull: the number of non-null observers:
+
+template< class T >
+std::size_t count_nonnull( observer_ptr<T> const * first, observer_ptr<T> const * last ) nsop_noexcept
+{
+    detail::require_pointer_layout<T>();
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    return n - detail::count_address( first, n, 0 );
+}
+
+// find: the first observer equal to value, last if none:
+
+template< class T >
+observer_ptr<T> const * find( observer_ptr<T> const * first, observer_ptr<T> const * last, typename detail::identity< observer_ptr<T> >::type value ) nsop_noexcept
+{
+    detail::require_pointer_layout<T>();
+    return first + detail::find_address( first, static_cast<std::size_t>( last - first ), detail::address_of( value ) );
+}
+
+template< class T >
+observer_ptr<T> * find( observer_ptr<T> * first, observer_ptr<T> * last, typename detail::identity< observer_ptr<T> >::type value ) nsop_noexcept
+{
+    detail::require_pointer_layout<T>();
+    return first + detail::find_address( first, static_cast<std::size_t>( last - first ), detail::address_of( value ) );
+}
+
+// find_first_null: the first null observer, last if none:
+
+template< class T >
+observer_ptr<T> const * find_first_null( observer_ptr<T> const * first, observer_ptr<T> const * last ) nsop_noexcept
+{
+    return observer_ptr_lite::find( first, last, observer_ptr<T>() );
+}
+
+template< class T >
+observer_ptr<T> * find_first_null( observer_ptr<T> * first, observer_ptr<T> * last ) nsop_noexcept
+{
+    return observer_ptr_lite::find( first, last, observer_ptr<T>() );
+}
+
+// contains: whether an observer is equal to value:
+
+template< class T >
+bool contains( observer_ptr<T> const * first, observer_ptr<T> const * last, typename detail::identity< observer_ptr<T> >::type value ) nsop_noexcept
+{
+    return observer_ptr_lite::find( first, last, value ) != last;
+}
+
+// all_of_equal: whether all observers are equal to value, true for an empty array:
+
+template< class T >
+bool all_of_equal( observer_ptr<T> const * first, observer_ptr<T> const * last, typename detail::identity< observer_ptr<T> >::type value ) nsop_noexcept
+{
+    detail::require_pointer_layout<T>();
+    return detail::all_address( first, static_cast<std::size_t>( last - first ), detail::address_of( value ) );
+}
+
+// compact_nonnull: move the non-null observers to the front, keeping their order, and
+// return the end of them, like std::remove(); the observers after it are unspecified:
+
+template< class T >
+observer_ptr<T> * compact_nonnull( observer_ptr<T> * first, observer_ptr<T> * last ) nsop_noexcept
+{
+    detail::require_pointer_layout<T>();
+
+    std::size_t const n = static_cast<std::size_t>( last - first );
+    std::size_t i = 0;
+    observer_ptr<T> * out = first;
+
+#if nsop_CONFIG_SIMD == nsop_SIMD_AVX512 || nsop_CONFIG_SIMD == nsop_SIMD_AVX2
+    // The output never runs ahead of the input, so that the stores only overwrite loaded observers:
+
+    detail::vec const null = detail::splat( 0 );
+
+    for ( ; i + detail::lanes <= n; i += detail::lanes )
+    {
+        detail::vec const v = detail::load( first + i );
+        unsigned const nonnull = ~detail::equal( v, null ) & detail::all_lanes;
+
+        detail::compress_store( out, nonnull, v );
+        out += detail::popcount( nonnull );
+    }
+#endif
+    for ( ; i != n; ++i )
+    {
+        *out = first[i];
+        out += static_cast<bool>( first[i] );
+    }
+    return out;
+}
+
+} // namespace nsop_SIMD_NAMESPACE
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::count_nonnull;
+using observer_ptr_lite::find;
+using observer_ptr_lite::find_first_null;
+using observer_ptr_lite::contains;
+using observer_ptr_lite::all_of_equal;
+using observer_ptr_lite::compact_nonnull;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_BULK_H_INCLUDED
+
+// end of file
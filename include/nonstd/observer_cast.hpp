@@ -0,0 +1,172 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::static_observer_cast<>() etc.: casts of observers, with a cached dynamic cast, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_CAST_H_INCLUDED
+#define NONSTD_OBSERVER_CAST_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <typeinfo>
+
+// Number of entries of the per-thread cache of a dynamic_observer_cast<T>() from a given
+// source type, a power of two:
+
+#ifndef  nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE
+# define nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE  8
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // cast_entry: a dynamic type, the offset of the source subobject in the complete object
+    // and the offset of the result of the cast, no_cast_result if the cast fails. A null
+    // type marks an empty entry:
+
+    struct cast_entry
+    {
+        std::type_info const * type;
+        std::ptrdiff_t source;
+        std::ptrdiff_t target;
+    };
+
+    const std::ptrdiff_t no_cast_result = (std::numeric_limits< std::ptrdiff_t >::min)();
+
+    // The entry for (type, source) of this thread's cache of casts from U to T; direct-mapped,
+    // a new entry replaces the one in its place. The cache is zero-initialized, so that it
+    // needs no initialization guard:
+
+    template< class T, class U >
+    cast_entry & cast_cache_entry( std::type_info const * type, std::ptrdiff_t source ) nsop_noexcept
+    {
+        static_assert( ( nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE & ( nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE - 1 ) ) == 0,
+            "nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE must be a power of two" );
+
+        static thread_local cast_entry cache[ nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE ];
+
+        std::uintptr_t const h = ( reinterpret_cast<std::uintptr_t>( type ) >> 4 ) ^ static_cast<std::uintptr_t>( source );
+
+        return cache[ ( h ^ ( h >> 8 ) ) & ( nsop_CONFIG_DYNAMIC_CAST_CACHE_SIZE - 1 ) ];
+    }
+
+    // p as T* if T is the dynamic type of *p and a static_cast from U* to T* is allowed,
+    // which excludes virtual, ambiguous and inaccessible bases; else null:
+
+    template< class T, class U >
+    auto exact_type_cast( U * p, std::type_info const & type, int ) nsop_noexcept -> decltype( static_cast<T *>( p ) )
+    {
+        return type == typeid( T ) ? static_cast<T *>( p ) : nsop_NULLPTR;
+    }
+
+    template< class T, class U >
+    T * exact_type_cast( U *, std::type_info const &, long ) nsop_noexcept
+    {
+        return nsop_NULLPTR;
+    }
+
+    // Conversion to a base class, no run-time check needed:
+
+    template< class T, class U >
+    T * cached_dynamic_cast( U * p, std::true_type ) nsop_noexcept
+    {
+        return p;
+    }
+
+    // Downcast or cross-cast: the exact type, else the cache, else dynamic_cast. The result
+    // only depends on the dynamic type and on which subobject of the complete object p
+    // refers to, its offset, which dynamic_cast<void *> yields without a hierarchy walk:
+
+    template< class T, class U >
+    T * cached_dynamic_cast( U * p, std::false_type )
+    {
+        static_assert( std::is_polymorphic<U>::value, "dynamic_observer_cast: source type must be polymorphic" );
+
+        if ( !p )
+            return nsop_NULLPTR;
+
+        std::type_info const & type = typeid( *p );
+
+        if ( T * const exact = exact_type_cast<T>( p, type, 0 ) )
+            return exact;
+
+        std::uintptr_t const complete = reinterpret_cast<std::uintptr_t>( dynamic_cast<void const volatile *>( p ) );
+        std::ptrdiff_t const source   = static_cast<std::ptrdiff_t>( reinterpret_cast<std::uintptr_t>( p ) - complete );
+
+        cast_entry & entry = cast_cache_entry<T, U>( &type, source );
+
+        if ( entry.type != &type || entry.source != source )
+        {
+            T * const result = dynamic_cast<T *>( p );
+
+            entry.type   = &type;
+            entry.source = source;
+            entry.target = result ? static_cast<std::ptrdiff_t>( reinterpret_cast<std::uintptr_t>( result ) - complete ) : no_cast_result;
+        }
+
+        return entry.target != no_cast_result
+            ? reinterpret_cast<T *>( complete + static_cast<std::uintptr_t>( entry.target ) )
+            : nsop_NULLPTR;
+    }
+} // namespace detail
+
+// Casts of observers, as std::static_pointer_cast() etc. of std::shared_ptr:
+
+template< class T, class U >
+observer_ptr<T> static_observer_cast( observer_ptr<U> const & p ) nsop_noexcept
+{
+    return observer_ptr<T>( static_cast<T *>( p.get() ) );
+}
+
+template< class T, class U >
+observer_ptr<T> const_observer_cast( observer_ptr<U> const & p ) nsop_noexcept
+{
+    return observer_ptr<T>( const_cast<T *>( p.get() ) );
+}
+
+template< class T, class U >
+observer_ptr<T> reinterpret_observer_cast( observer_ptr<U> const & p ) nsop_noexcept
+{
+    return observer_ptr<T>( reinterpret_cast<T *>( p.get() ) );
+}
+
+// dynamic_observer_cast: the result of dynamic_cast<T *>( p.get() ). If T is the dynamic type
+// of *p, a type_info compare suffices. Else the result is taken from a per-thread cache of
+// the offsets of earlier casts from U to T of objects of the same dynamic type, so that a
+// repeated cast skips the walk of the class hierarchy. A conversion to a base class of U is
+// static.
+
+template< class T, class U >
+observer_ptr<T> dynamic_observer_cast( observer_ptr<U> const & p )
+{
+    return observer_ptr<T>( detail::cached_dynamic_cast<T>( p.get(), std::is_convertible<U *, T *>() ) );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::static_observer_cast;
+using observer_ptr_lite::const_observer_cast;
+using observer_ptr_lite::reinterpret_observer_cast;
+using observer_ptr_lite::dynamic_observer_cast;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_CAST_H_INCLUDED
+
+// end of file
@@ -0,0 +1,248 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::dyn_observer<>: non-owning type-erased interface observer with a static function table, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_DYN_H_INCLUDED
+#define NONSTD_OBSERVER_DYN_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    template< class... >
+    struct make_void
+    {
+        typedef void type;
+    };
+
+    // The function table of Interface for T, initialized at compile time:
+
+    template< class Interface, class T >
+    struct dyn_table
+    {
+        static constexpr typename Interface::table value = Interface::template table_for<T>();
+    };
+
+    template< class Interface, class T >
+    constexpr typename Interface::table dyn_table<Interface, T>::value;
+
+    // The base class with the member functions of the interface, Interface::methods<Self>
+    // if present, else empty:
+
+    template< class Interface, class Self, class = void >
+    struct dyn_methods
+    {
+        struct type {};
+    };
+
+    template< class Interface, class Self >
+    struct dyn_methods< Interface, Self, typename make_void< typename Interface::template methods<Self> >::type >
+    {
+        typedef typename Interface::template methods<Self> type;
+    };
+} // namespace detail
+
+// dyn_observer: observer of an object of any type that conforms to Interface, as a pointer
+// to the object and a pointer to a function table for its type, without inheritance, virtual
+// functions or allocation. Interface provides:
+// - table: a struct of function pointers that take the object as void * or void const *;
+// - template< class T > static constexpr table table_for(): the table for objects of type T;
+// - optionally template< class Self > struct methods: the member functions of dyn_observer,
+//   that forward to call().
+// dyn_observer<Interface const> observes an object as const: it accepts a T const and only
+// calls functions that take void const *; dyn_observer<Interface> does not accept a T const.
+// The table of a type is a constant, so that where the constructor is inlined, the compiler
+// sees the actual function and may inline it. Comparison and hashing are of the address of
+// the object.
+
+template< class Interface >
+class dyn_observer : public detail::dyn_methods< typename std::remove_const<Interface>::type, dyn_observer<Interface> >::type
+{
+public:
+    typedef typename std::remove_const<Interface>::type interface_type;
+    typedef typename interface_type::table table_type;
+    typedef typename std::conditional< std::is_const<Interface>::value, void const, void >::type * pointer;
+
+    nsop_constexpr dyn_observer() nsop_noexcept
+    : object( nsop_NULLPTR ), vtable( nsop_NULLPTR ) {}
+
+    nsop_constexpr dyn_observer( std::nullptr_t ) nsop_noexcept
+    : object( nsop_NULLPTR ), vtable( nsop_NULLPTR ) {}
+
+    template< class T
+        nsop_REQUIRES_T(( std::is_convertible<T *, pointer>::value ))
+    >
+    dyn_observer( observer_ptr<T> p ) nsop_noexcept
+    : object( p.get() )
+    , vtable( p ? &detail::dyn_table<interface_type, typename std::remove_const<T>::type>::value : nsop_NULLPTR ) {}
+
+    template< class T
+        nsop_REQUIRES_T(( std::is_convertible<T *, pointer>::value ))
+    >
+    explicit dyn_observer( T * p ) nsop_noexcept
+    : dyn_observer( observer_ptr<T>( p ) ) {}
+
+    // From a dyn_observer<Interface> to a dyn_observer<Interface const>:
+
+    template< class I
+        nsop_REQUIRES_T(( std::is_const<Interface>::value && std::is_same<I, interface_type>::value ))
+    >
+    dyn_observer( dyn_observer<I> const & other ) nsop_noexcept
+    : object( other.get() )
+    , vtable( other ? &other.table() : nsop_NULLPTR ) {}
+
+    // The observed object and its function table:
+
+    pointer get() const nsop_noexcept
+    {
+        return object;
+    }
+
+    table_type const & table() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( vtable != nsop_NULLPTR );
+        return *vtable;
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return object != nsop_NULLPTR;
+    }
+
+    // Call function f of the table with the object and args:
+
+    template< class F, class... Args >
+    auto call( F table_type::* f, Args &&... args ) const
+        -> decltype( ( std::declval<table_type const &>().*f )( std::declval<pointer>(), std::forward<Args>( args )... ) )
+    {
+        return ( table().*f )( object, std::forward<Args>( args )... );
+    }
+
+    void reset() nsop_noexcept
+    {
+        object = nsop_NULLPTR;
+        vtable = nsop_NULLPTR;
+    }
+
+    void swap( dyn_observer & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( object, other.object );
+        swap( vtable, other.vtable );
+    }
+
+private:
+    pointer object;
+    table_type const * vtable;
+};
+
+// specialized algorithms:
+
+template< class Interface >
+void swap( dyn_observer<Interface> & p1, dyn_observer<Interface> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class Interface >
+bool operator==( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class Interface >
+bool operator!=( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class Interface >
+bool operator==( dyn_observer<Interface> const & p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class Interface >
+bool operator==( std::nullptr_t, dyn_observer<Interface> const & p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class Interface >
+bool operator!=( dyn_observer<Interface> const & p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class Interface >
+bool operator!=( std::nullptr_t, dyn_observer<Interface> const & p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class Interface >
+bool operator<( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return std::less< void const * >()( p1.get(), p2.get() );
+}
+
+template< class Interface >
+bool operator>( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class Interface >
+bool operator<=( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class Interface >
+bool operator>=( dyn_observer<Interface> const & p1, dyn_observer<Interface> const & p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::dyn_observer;
+
+} // namespace nonstd
+
+namespace std
+{
+
+template< class Interface >
+struct hash< ::nonstd::dyn_observer<Interface> >
+{
+    size_t operator()( ::nonstd::dyn_observer<Interface> const & p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+}
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_DYN_H_INCLUDED
+
+// end of file
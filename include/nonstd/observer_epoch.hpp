@@ -0,0 +1,305 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::epoch_domain and nonstd::epoch_guard: epoch-based reclamation for readers of observer_ptrs, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_EPOCH_H_INCLUDED
+#define NONSTD_OBSERVER_EPOCH_H_INCLUDED
+
+#include "observer_atomic.hpp"
+#include "observer_reclaim.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <memory>
+#include <vector>
+
+// Number of objects a thread retires before it tries to advance the epoch and to
+// reclaim objects:
+
+#ifndef  nsop_CONFIG_EPOCH_COLLECT_THRESHOLD
+# define nsop_CONFIG_EPOCH_COLLECT_THRESHOLD  64
+#endif
+
+// Number of domains per thread with a cached epoch record:
+
+#ifndef  nsop_CONFIG_EPOCH_DOMAINS_PER_THREAD
+# define nsop_CONFIG_EPOCH_DOMAINS_PER_THREAD  4
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // epoch_record: the epoch a thread is pinned to and the objects it retired in the last
+    // three epochs. The pinned epoch shares a cache line with the list links, the data
+    // private to the owning thread starts the next.
+
+    struct alignas( nsop_CONFIG_CACHE_LINE_SIZE ) epoch_record : thread_record< epoch_record >
+    {
+        enum { buckets = 3 };
+
+        // ( epoch << 1 ) | 1 while pinned, 0 otherwise:
+
+        std::atomic<std::uint64_t> pinned;
+
+        alignas( nsop_CONFIG_CACHE_LINE_SIZE )
+        unsigned                    nesting;
+        std::size_t                 retired;
+        std::uint64_t               epoch[ buckets ];
+        std::vector<retired_object> limbo[ buckets ];
+
+        epoch_record() nsop_noexcept
+        : pinned( 0 ), nesting( 0 ), retired( 0 )
+        {
+            for ( auto & e : epoch )
+            {
+                e = 0;
+            }
+        }
+
+        // Reclaim the objects of a bucket; reclaiming may retire further objects:
+
+        void reclaim( std::size_t bucket )
+        {
+            std::vector<retired_object> objects;
+            objects.swap( limbo[ bucket ] );
+            retired -= objects.size();
+
+            for ( auto & r : objects )
+            {
+                r.reclaim( r.object );
+            }
+        }
+    };
+} // namespace detail
+
+class epoch_domain;
+
+// epoch_guard: pins the calling thread to the current epoch of a domain. While pinned, objects
+// loaded from the domain's data structures are not reclaimed, however many the thread loads.
+// Guards nest; a guard must be destroyed by the thread that created it.
+
+class epoch_guard
+{
+public:
+    explicit epoch_guard( epoch_domain & domain );
+
+    epoch_guard( epoch_guard && other ) nsop_noexcept
+    : record( other.record ), temporary( other.temporary )
+    {
+        other.record = nsop_NULLPTR;
+    }
+
+    epoch_guard( epoch_guard const & ) = delete;
+    epoch_guard & operator=( epoch_guard const & ) = delete;
+    epoch_guard & operator=( epoch_guard && ) = delete;
+
+    ~epoch_guard()
+    {
+        if ( record && --record->nesting == 0 )
+        {
+            record->pinned.store( 0, std::memory_order_release );
+
+            if ( temporary )
+                detail::release_record( record );
+        }
+    }
+
+    // Load an observer that remains valid while the guard lives:
+
+    template< class T >
+    observer_ptr<T> load( atomic_observer_ptr<T> const & src, std::memory_order order = std::memory_order_acquire ) const nsop_noexcept
+    {
+        return src.load( order );
+    }
+
+    template< class T >
+    observer_ptr<T> load( std::atomic<T *> const & src, std::memory_order order = std::memory_order_acquire ) const nsop_noexcept
+    {
+        return observer_ptr<T>( src.load( order ) );
+    }
+
+    // The epoch the thread is pinned to:
+
+    std::uint64_t epoch() const nsop_noexcept
+    {
+        return record ? record->pinned.load( std::memory_order_relaxed ) >> 1 : 0;
+    }
+
+private:
+    detail::epoch_record * record;
+    bool                   temporary;
+};
+
+// epoch_domain: a global epoch, advanced when all pinned threads have seen it. An object
+// retired in epoch e is reclaimed once the epoch reaches e + 2, when no thread can still
+// observe it. A domain must outlive its guards and must not be in use when it is destroyed.
+
+class epoch_domain
+{
+public:
+    explicit epoch_domain( std::size_t collect_threshold = nsop_CONFIG_EPOCH_COLLECT_THRESHOLD )
+    : global( 0 ), threshold( collect_threshold ) {}
+
+    epoch_domain( epoch_domain const & ) = delete;
+    epoch_domain & operator=( epoch_domain const & ) = delete;
+
+    // Reclaim all retired objects:
+
+    ~epoch_domain()
+    {
+        for ( detail::epoch_record * rec = records.first(); rec; rec = rec->next )
+        {
+            for ( std::size_t b = 0; b != detail::epoch_record::buckets; ++b )
+            {
+                rec->reclaim( b );
+            }
+        }
+    }
+
+    epoch_guard pin()
+    {
+        return epoch_guard( *this );
+    }
+
+    // Retire an object that is no longer reachable from the domain's data structures;
+    // D is default-constructed to reclaim it two epochs later:
+
+    template< class T, class D = std::default_delete<T> >
+    void retire( T * p, D = D() )
+    {
+        if ( p == nsop_NULLPTR )
+            return;
+
+        bool temporary = false;
+        detail::epoch_record * const rec = records.thread_record( temporary );
+
+        // The fence orders the caller's unlink before the load of the epoch and pairs with the
+        // fence in enter(): a reader that can still load the object is pinned to e or earlier.
+
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        std::uint64_t const e = global.load( std::memory_order_acquire );
+        std::size_t   const b = static_cast<std::size_t>( e % detail::epoch_record::buckets );
+
+        // A bucket that holds objects of an earlier epoch holds them for three epochs or more:
+
+        if ( rec->epoch[b] != e )
+        {
+            rec->reclaim( b );
+            rec->epoch[b] = e;
+        }
+
+        rec->limbo[b].push_back( detail::make_retired<T, D>( p ) );
+
+        if ( ++rec->retired >= threshold )
+            collect( rec );
+
+        if ( temporary )
+            detail::release_record( rec );
+    }
+
+    // Try to advance the epoch and reclaim the objects of this thread that no thread can observe:
+
+    void collect()
+    {
+        bool temporary = false;
+        detail::epoch_record * const rec = records.thread_record( temporary );
+
+        collect( rec );
+
+        if ( temporary )
+            detail::release_record( rec );
+    }
+
+    std::uint64_t epoch() const nsop_noexcept
+    {
+        return global.load( std::memory_order_relaxed );
+    }
+
+private:
+    friend class epoch_guard;
+
+    detail::epoch_record * enter( bool & temporary )
+    {
+        detail::epoch_record * const rec = records.thread_record( temporary );
+
+        if ( rec->nesting++ == 0 )
+        {
+            rec->pinned.store( ( global.load( std::memory_order_relaxed ) << 1 ) | 1, std::memory_order_relaxed );
+            std::atomic_thread_fence( std::memory_order_seq_cst );
+        }
+        return rec;
+    }
+
+    // Advance the epoch if all pinned threads are pinned to the current one:
+
+    bool try_advance() nsop_noexcept
+    {
+        std::uint64_t e = global.load( std::memory_order_relaxed );
+
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        for ( detail::epoch_record * rec = records.first(); rec; rec = rec->next )
+        {
+            std::uint64_t const pinned = rec->pinned.load( std::memory_order_relaxed );
+
+            if ( ( pinned & 1 ) && ( pinned >> 1 ) != e )
+                return false;
+        }
+
+        std::atomic_thread_fence( std::memory_order_acquire );
+
+        return global.compare_exchange_strong( e, e + 1, std::memory_order_release, std::memory_order_relaxed );
+    }
+
+    void collect( detail::epoch_record * rec )
+    {
+        try_advance();
+
+        std::uint64_t const e = global.load( std::memory_order_acquire );
+
+        for ( std::size_t b = 0; b != detail::epoch_record::buckets; ++b )
+        {
+            if ( !rec->limbo[b].empty() && rec->epoch[b] + 2 <= e )
+                rec->reclaim( b );
+        }
+    }
+
+    std::atomic<std::uint64_t> global;
+    std::size_t const          threshold;
+    detail::record_list< detail::epoch_record, nsop_CONFIG_EPOCH_DOMAINS_PER_THREAD > records;
+};
+
+inline epoch_guard::epoch_guard( epoch_domain & d )
+: record( d.enter( temporary ) ) {}
+
+// The domain for general use:
+
+inline epoch_domain & default_epoch_domain()
+{
+    static epoch_domain domain;
+    return domain;
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::epoch_guard;
+using observer_ptr_lite::epoch_domain;
+using observer_ptr_lite::default_epoch_domain;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_EPOCH_H_INCLUDED
+
+// end of file
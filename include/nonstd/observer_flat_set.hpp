@@ -0,0 +1,326 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_flat_set<>: sorted set of observers in a flat Eytzinger array, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_FLAT_SET_H_INCLUDED
+#define NONSTD_OBSERVER_FLAT_SET_H_INCLUDED
+
+#include "observer_prefetch.hpp"
+#include "observer_sort.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <vector>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // Number of trailing one bits of k:
+
+    inline unsigned trailing_ones( std::size_t k ) nsop_noexcept
+    {
+#if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+        return static_cast<unsigned>( __builtin_ctzll( ~static_cast<unsigned long long>( k ) ) );
+#else
+        unsigned n = 0;
+        for ( ; k & 1; k >>= 1 )
+            ++n;
+        return n;
+#endif
+    }
+
+    // Fill the Eytzinger tree [1, n] from sorted[i...] in order: the children of node k are
+    // 2k and 2k + 1:
+
+    template< class T >
+    void fill_eytzinger( std::vector< observer_ptr<T> > & tree, observer_ptr<T> const * & sorted, std::size_t k )
+    {
+        if ( k < tree.size() )
+        {
+            fill_eytzinger( tree, sorted, 2 * k );
+            tree[k] = *sorted++;
+            fill_eytzinger( tree, sorted, 2 * k + 1 );
+        }
+    }
+} // namespace detail
+
+// observer_flat_set: set of observers for read-mostly membership tests. The observers are
+// sorted in the order of operator< and stored in one array in Eytzinger (BFS) order, so that
+// the first levels of the search share cache lines. lower_bound() is branchless and
+// prefetches the nodes three levels down; iteration is in order. Construction and insert()
+// of a range sort their input and rebuild the array in O(n); there is no single-element
+// insert or erase.
+
+template< class T >
+class observer_flat_set
+{
+public:
+    typedef observer_ptr<T> key_type;
+    typedef observer_ptr<T> value_type;
+    typedef std::size_t     size_type;
+
+    // const_iterator: in-order traversal of the tree; end is node 0:
+
+    class const_iterator
+    {
+    public:
+        typedef std::forward_iterator_tag iterator_category;
+        typedef observer_ptr<T>           value_type;
+        typedef observer_ptr<T> const &   reference;
+        typedef observer_ptr<T> const *   pointer;
+        typedef std::ptrdiff_t            difference_type;
+
+        const_iterator() nsop_noexcept
+        : tree( nsop_NULLPTR ), n( 0 ), k( 0 ) {}
+
+        const_iterator( observer_ptr<T> const * t, std::size_t size, std::size_t node ) nsop_noexcept
+        : tree( t ), n( size ), k( node ) {}
+
+        reference operator*() const nsop_noexcept
+        {
+            return tree[k];
+        }
+
+        pointer operator->() const nsop_noexcept
+        {
+            return &tree[k];
+        }
+
+        // Next in order: the leftmost node of the right subtree, else the first ancestor of
+        // which this node is in the left subtree:
+
+        const_iterator & operator++() nsop_noexcept
+        {
+            if ( 2 * k + 1 <= n )
+            {
+                k = 2 * k + 1;
+
+                while ( 2 * k <= n )
+                    k = 2 * k;
+            }
+            else
+            {
+                k >>= detail::trailing_ones( k ) + 1;
+            }
+            return *this;
+        }
+
+        const_iterator operator++( int ) nsop_noexcept
+        {
+            const_iterator result( *this );
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==( const_iterator const & a, const_iterator const & b ) nsop_noexcept
+        {
+            return a.k == b.k;
+        }
+
+        friend bool operator!=( const_iterator const & a, const_iterator const & b ) nsop_noexcept
+        {
+            return a.k != b.k;
+        }
+
+    private:
+        observer_ptr<T> const * tree;
+        std::size_t n;
+        std::size_t k;
+    };
+
+    typedef const_iterator iterator;
+
+    observer_flat_set()
+    : tree( 1 ) {}
+
+    template< class It >
+    observer_flat_set( It first, It last )
+    : tree( 1 )
+    {
+        std::vector< observer_ptr<T> > v( first, last );
+        assign_unsorted( v );
+    }
+
+    observer_flat_set( std::initializer_list< observer_ptr<T> > keys )
+    : tree( 1 )
+    {
+        std::vector< observer_ptr<T> > v( keys );
+        assign_unsorted( v );
+    }
+
+    explicit observer_flat_set( std::vector< observer_ptr<T> > keys )
+    : tree( 1 )
+    {
+        assign_unsorted( keys );
+    }
+
+    size_type size() const nsop_noexcept
+    {
+        return tree.size() - 1;
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return tree.size() == 1;
+    }
+
+    // First observer not less than key, end() if none:
+
+    const_iterator lower_bound( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return const_iterator( tree.data(), size(), lower_bound_node( key ) );
+    }
+
+    const_iterator find( observer_ptr<T> key ) const nsop_noexcept
+    {
+        std::size_t const k = lower_bound_node( key );
+        return const_iterator( tree.data(), size(), k != 0 && tree[k] == key ? k : 0 );
+    }
+
+    bool contains( observer_ptr<T> key ) const nsop_noexcept
+    {
+        std::size_t const k = lower_bound_node( key );
+        return k != 0 && tree[k] == key;
+    }
+
+    size_type count( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return contains( key ) ? 1 : 0;
+    }
+
+    // Insert the observers of [first, last): sort them and merge them with the set:
+
+    template< class It >
+    void insert( It first, It last )
+    {
+        std::vector< observer_ptr<T> > added( first, last );
+        sort_by_address( added );
+
+        std::vector< observer_ptr<T> > const present = sorted();
+        std::vector< observer_ptr<T> > merged( present.size() + added.size() );
+
+        merged.erase( std::merge( present.begin(), present.end(), added.begin(), added.end(), merged.begin(), less() ), merged.end() );
+        unique_by_address( merged );
+        assign_sorted( merged );
+    }
+
+    void insert( std::initializer_list< observer_ptr<T> > keys )
+    {
+        insert( keys.begin(), keys.end() );
+    }
+
+    void clear()
+    {
+        tree.assign( 1, observer_ptr<T>() );
+    }
+
+    void swap( observer_flat_set & other ) nsop_noexcept
+    {
+        tree.swap( other.tree );
+    }
+
+    const_iterator begin() const nsop_noexcept
+    {
+        if ( empty() )
+            return end();
+
+        std::size_t k = 1;
+
+        while ( 2 * k <= size() )
+            k = 2 * k;
+
+        return const_iterator( tree.data(), size(), k );
+    }
+
+    const_iterator end() const nsop_noexcept
+    {
+        return const_iterator( tree.data(), size(), 0 );
+    }
+
+    // The observers in order:
+
+    std::vector< observer_ptr<T> > sorted() const
+    {
+        return std::vector< observer_ptr<T> >( begin(), end() );
+    }
+
+private:
+    struct less
+    {
+        bool operator()( observer_ptr<T> const & a, observer_ptr<T> const & b ) const nsop_noexcept
+        {
+            return detail::address_of( a ) < detail::address_of( b );
+        }
+    };
+
+    // Descend to the left if the node is not less than key, to the right else; the last
+    // left turn, found by removing the trailing right turns, is the lower bound. Node 0 if
+    // all nodes are less. The 8 descendants three levels down are adjacent and prefetched:
+
+    std::size_t lower_bound_node( observer_ptr<T> key ) const nsop_noexcept
+    {
+        std::uintptr_t const a = detail::address_of( key );
+        std::uintptr_t const base = reinterpret_cast<std::uintptr_t>( tree.data() );
+        std::size_t const n = size();
+        std::size_t k = 1;
+
+        while ( k <= n )
+        {
+            detail::prefetch_address< prefetch_access::read, prefetch_locality::high >(
+                reinterpret_cast<void const *>( base + 8 * k * sizeof( observer_ptr<T> ) ) );
+
+            k = 2 * k + ( detail::address_of( tree[k] ) < a );
+        }
+        return k >> ( detail::trailing_ones( k ) + 1 );
+    }
+
+    void assign_unsorted( std::vector< observer_ptr<T> > & v )
+    {
+        sort_by_address( v );
+        unique_by_address( v );
+        assign_sorted( v );
+    }
+
+    void assign_sorted( std::vector< observer_ptr<T> > const & v )
+    {
+        std::vector< observer_ptr<T> > next( v.size() + 1 );
+        observer_ptr<T> const * pos = v.data();
+
+        detail::fill_eytzinger( next, pos, 1 );
+        tree.swap( next );
+    }
+
+    std::vector< observer_ptr<T> > tree;    // tree[0] is unused
+};
+
+template< class T >
+void swap( observer_flat_set<T> & a, observer_flat_set<T> & b ) nsop_noexcept
+{
+    a.swap( b );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::observer_flat_set;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_FLAT_SET_H_INCLUDED
+
+// end of file
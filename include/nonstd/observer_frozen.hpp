@@ -0,0 +1,426 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::frozen_observer_set<> and nonstd::frozen_observer_map<>: immutable observer sets and maps with a minimal perfect hash, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_FROZEN_H_INCLUDED
+#define NONSTD_OBSERVER_FROZEN_H_INCLUDED
+
+#include "observer_sort.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Average number of keys per bucket of the perfect hash; a pilot takes 4 bytes per bucket:
+
+#ifndef  nsop_CONFIG_FROZEN_KEYS_PER_BUCKET
+# define nsop_CONFIG_FROZEN_KEYS_PER_BUCKET  4
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // 64-bit finalizer of SplitMix64, a bijection:
+
+    inline std::uint64_t mix64( std::uint64_t x ) nsop_noexcept
+    {
+        x = ( x ^ ( x >> 30 ) ) * 0xBF58476D1CE4E5B9ull;
+        x = ( x ^ ( x >> 27 ) ) * 0x94D049BB133111EBull;
+        return x ^ ( x >> 31 );
+    }
+
+    // Map x to [0, n) by the high half of x * n, without a division where available:
+
+    inline std::size_t reduce( std::uint64_t x, std::size_t n ) nsop_noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        return static_cast<std::size_t>( ( static_cast<unsigned __int128>( x ) * n ) >> 64 );
+#else
+        return static_cast<std::size_t>( x % n );
+#endif
+    }
+
+    // perfect_hash: minimal perfect hash of n distinct addresses onto [0, n), by hash and
+    // displace (PTHash): a key hashes to a bucket and, with the pilot of its bucket, to a
+    // slot. The pilots are searched at construction, for the largest buckets first, so that
+    // the keys of each bucket land in distinct free slots. A lookup computes one hash and
+    // reads one pilot; it never probes.
+
+    class perfect_hash
+    {
+    public:
+        perfect_hash() nsop_noexcept
+        : seed( 0 ), slots( 0 ) {}
+
+        // Build for the distinct addresses of [first, first + n):
+
+        template< class T >
+        explicit perfect_hash( observer_ptr<T> const * first, std::size_t n )
+        : seed( 0 ), slots( n )
+        {
+            if ( n == 0 )
+                return;
+
+            std::size_t const buckets = n / nsop_CONFIG_FROZEN_KEYS_PER_BUCKET + 1;
+
+            for ( ;; ++seed )
+            {
+                if ( search_pilots( first, n, buckets ) )
+                    return;
+            }
+        }
+
+        std::size_t size() const nsop_noexcept
+        {
+            return slots;
+        }
+
+        // The slot of address a, in [0, n); for an address that was not built for, any slot:
+
+        std::size_t operator()( std::uintptr_t a ) const nsop_noexcept
+        {
+            std::uint64_t const h = key_hash( a );
+            return slot_of( h, pilots[ reduce( h, pilots.size() ) ] );
+        }
+
+    private:
+        std::uint64_t key_hash( std::uintptr_t a ) const nsop_noexcept
+        {
+            return mix64( static_cast<std::uint64_t>( a ) ^ seed );
+        }
+
+        std::size_t slot_of( std::uint64_t h, std::uint32_t pilot ) const nsop_noexcept
+        {
+            return reduce( mix64( h ^ ( ( pilot + 1ull ) * 0x9E3779B97F4A7C15ull ) ), slots );
+        }
+
+        // Find a pilot for each bucket, largest bucket first; false if a bucket exhausts the
+        // pilots, the caller then retries with another seed:
+
+        template< class T >
+        bool search_pilots( observer_ptr<T> const * first, std::size_t n, std::size_t buckets )
+        {
+            std::vector< std::uint64_t > hashes( n );
+            std::vector< std::size_t > start( buckets + 1 );
+
+            for ( std::size_t i = 0; i != n; ++i )
+            {
+                hashes[i] = key_hash( reinterpret_cast<std::uintptr_t>( first[i].get() ) );
+                ++start[ reduce( hashes[i], buckets ) + 1 ];
+            }
+
+            // group the hashes by bucket; order the buckets by size, largest first:
+
+            std::size_t largest = 0;
+
+            for ( std::size_t b = 0; b != buckets; ++b )
+            {
+                largest = std::max( largest, start[ b + 1 ] );
+                start[ b + 1 ] += start[b];
+            }
+
+            std::vector< std::uint64_t > grouped( n );
+            std::vector< std::size_t > fill( start.begin(), start.end() - 1 );
+
+            for ( std::size_t i = 0; i != n; ++i )
+            {
+                grouped[ fill[ reduce( hashes[i], buckets ) ]++ ] = hashes[i];
+            }
+
+            std::vector< std::size_t > by_size( largest + 2 );
+            std::vector< std::size_t > order( buckets );
+
+            for ( std::size_t b = 0; b != buckets; ++b )
+                ++by_size[ largest - ( start[ b + 1 ] - start[b] ) + 1 ];
+
+            for ( std::size_t s = 0; s != largest + 1; ++s )
+                by_size[ s + 1 ] += by_size[s];
+
+            for ( std::size_t b = 0; b != buckets; ++b )
+                order[ by_size[ largest - ( start[ b + 1 ] - start[b] ) ]++ ] = b;
+
+            // place the buckets:
+
+            std::uint64_t const max_pilot = 64 * static_cast<std::uint64_t>( n ) + 1024;
+
+            std::vector< bool > taken( n );
+            std::vector< std::size_t > placed;
+
+            pilots.assign( buckets, 0 );
+
+            for ( std::size_t b : order )
+            {
+                std::uint64_t pilot = 0;
+
+                for ( ; pilot != max_pilot; ++pilot )
+                {
+                    placed.clear();
+
+                    for ( std::size_t i = start[b]; i != start[ b + 1 ]; ++i )
+                    {
+                        std::size_t const s = slot_of( grouped[i], static_cast<std::uint32_t>( pilot ) );
+
+                        if ( taken[s] )
+                            break;
+
+                        taken[s] = true;
+                        placed.push_back( s );
+                    }
+
+                    if ( placed.size() == start[ b + 1 ] - start[b] )
+                        break;
+
+                    for ( std::size_t s : placed )
+                        taken[s] = false;
+                }
+
+                if ( pilot == max_pilot || pilot > 0xFFFFFFFFull )
+                    return false;
+
+                pilots[b] = static_cast<std::uint32_t>( pilot );
+            }
+            return true;
+        }
+
+        std::uint64_t seed;
+        std::size_t slots;
+        std::vector< std::uint32_t > pilots;
+    };
+
+    // The distinct observers of v, in address order:
+
+    template< class T >
+    void make_distinct( std::vector< observer_ptr<T> > & v )
+    {
+        sort_by_address( v );
+        unique_by_address( v );
+    }
+} // namespace detail
+
+// frozen_observer_set: immutable set of observers with a minimal perfect hash, for sets that
+// are fixed after initialization. The observers are stored in the n slots the perfect hash
+// maps them to. contains() computes one hash, reads one pilot and compares one observer.
+// Construction takes expected O(n log n) time.
+
+template< class T >
+class frozen_observer_set
+{
+public:
+    typedef observer_ptr<T> key_type;
+    typedef observer_ptr<T> value_type;
+    typedef std::size_t     size_type;
+
+    typedef typename std::vector< observer_ptr<T> >::const_iterator const_iterator;
+    typedef const_iterator iterator;
+
+    frozen_observer_set() {}
+
+    explicit frozen_observer_set( std::vector< observer_ptr<T> > keys )
+    {
+        detail::make_distinct( keys );
+        hash  = detail::perfect_hash( keys.data(), keys.size() );
+        slots = std::vector< observer_ptr<T> >( keys.size() );
+
+        for ( observer_ptr<T> key : keys )
+            slots[ hash( detail::address_of( key ) ) ] = key;
+    }
+
+    template< class It >
+    frozen_observer_set( It first, It last )
+    : frozen_observer_set( std::vector< observer_ptr<T> >( first, last ) ) {}
+
+    frozen_observer_set( std::initializer_list< observer_ptr<T> > keys )
+    : frozen_observer_set( std::vector< observer_ptr<T> >( keys ) ) {}
+
+    size_type size() const nsop_noexcept
+    {
+        return slots.size();
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return slots.empty();
+    }
+
+    bool contains( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return !slots.empty() && slots[ hash( detail::address_of( key ) ) ] == key;
+    }
+
+    size_type count( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return contains( key ) ? 1 : 0;
+    }
+
+    // Iteration in the order of the slots:
+
+    const_iterator begin() const nsop_noexcept
+    {
+        return slots.begin();
+    }
+
+    const_iterator end() const nsop_noexcept
+    {
+        return slots.end();
+    }
+
+private:
+    detail::perfect_hash hash;
+    std::vector< observer_ptr<T> > slots;
+};
+
+// frozen_observer_map: immutable map from observers to values of V with a minimal perfect
+// hash; the keys are fixed, the values may change. at() and find() compute one hash, read one
+// pilot and compare one observer. Of duplicate keys, the first one's value is kept.
+
+template< class T, class V >
+class frozen_observer_map
+{
+public:
+    typedef observer_ptr<T> key_type;
+    typedef V               mapped_type;
+    typedef std::size_t     size_type;
+
+    frozen_observer_map() {}
+
+    explicit frozen_observer_map( std::vector< std::pair< observer_ptr<T>, V > > entries )
+    {
+        std::vector< observer_ptr<T> > keys;
+        keys.reserve( entries.size() );
+
+        for ( std::pair< observer_ptr<T>, V > const & entry : entries )
+            keys.push_back( entry.first );
+
+        detail::make_distinct( keys );
+        hash  = detail::perfect_hash( keys.data(), keys.size() );
+        slots = std::vector< observer_ptr<T> >( keys.size() );
+        values.resize( keys.size() );
+
+        // the value of the first entry of a key, via reverse order:
+
+        for ( std::size_t i = entries.size(); i != 0; --i )
+        {
+            std::size_t const s = hash( detail::address_of( entries[ i - 1 ].first ) );
+
+            slots[s]  = entries[ i - 1 ].first;
+            values[s] = std::move( entries[ i - 1 ].second );
+        }
+    }
+
+    frozen_observer_map( std::initializer_list< std::pair< observer_ptr<T>, V > > entries )
+    : frozen_observer_map( std::vector< std::pair< observer_ptr<T>, V > >( entries ) ) {}
+
+    size_type size() const nsop_noexcept
+    {
+        return slots.size();
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return slots.empty();
+    }
+
+    bool contains( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return !slots.empty() && slots[ hash( detail::address_of( key ) ) ] == key;
+    }
+
+    size_type count( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return contains( key ) ? 1 : 0;
+    }
+
+    // Observer of the value of key, null if key is absent:
+
+    observer_ptr<V> find( observer_ptr<T> key ) nsop_noexcept
+    {
+        std::size_t const s = slot( key );
+        return s != slots.size() ? observer_ptr<V>( &values[s] ) : observer_ptr<V>();
+    }
+
+    observer_ptr<V const> find( observer_ptr<T> key ) const nsop_noexcept
+    {
+        std::size_t const s = slot( key );
+        return s != slots.size() ? observer_ptr<V const>( &values[s] ) : observer_ptr<V const>();
+    }
+
+    // The value of key; throws std::out_of_range if key is absent:
+
+    V & at( observer_ptr<T> key )
+    {
+        return values[ index_of( key ) ];
+    }
+
+    V const & at( observer_ptr<T> key ) const
+    {
+        return values[ index_of( key ) ];
+    }
+
+    // The keys and the values, in the order of the slots:
+
+    std::vector< observer_ptr<T> > const & keys() const nsop_noexcept
+    {
+        return slots;
+    }
+
+    std::vector< V > const & mapped() const nsop_noexcept
+    {
+        return values;
+    }
+
+private:
+    // The slot of key, size() if key is absent:
+
+    std::size_t slot( observer_ptr<T> key ) const nsop_noexcept
+    {
+        if ( slots.empty() )
+            return 0;
+
+        std::size_t const s = hash( detail::address_of( key ) );
+        return slots[s] == key ? s : slots.size();
+    }
+
+    // The slot of key; throws std::out_of_range if key is absent:
+
+    std::size_t index_of( observer_ptr<T> key ) const
+    {
+        std::size_t const s = slot( key );
+
+        if ( s == slots.size() )
+            throw std::out_of_range( "frozen_observer_map::at: key not present" );
+
+        return s;
+    }
+
+    detail::perfect_hash hash;
+    std::vector< observer_ptr<T> > slots;
+    std::vector< V > values;
+};
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::frozen_observer_set;
+using observer_ptr_lite::frozen_observer_map;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_FROZEN_H_INCLUDED
+
+// end of file
@@ -0,0 +1,173 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::function_ref<>: non-owning observer of a callable, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_FUNCTION_H_INCLUDED
+#define NONSTD_OBSERVER_FUNCTION_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+// member_t<M, m>: tag for the member function m of type M, to bind a function_ref to a member
+// function and an object; as of C++17, member<&T::f>:
+
+template< class M, M m >
+struct member_t {};
+
+#if nsop_CPP17_OR_GREATER
+template< auto m >
+constexpr member_t< decltype( m ), m > member{};
+#endif
+
+namespace detail
+{
+    // Whether F can be called with Args and its result converts to R:
+
+    template< class F, class R, class... Args >
+    struct is_callable_r
+    {
+        template< class G >
+        static auto test( int ) -> typename std::integral_constant< bool,
+            std::is_void<R>::value || std::is_convertible< decltype( std::declval<G &>()( std::declval<Args>()... ) ), R >::value >;
+
+        template< class G >
+        static std::false_type test( ... );
+
+        static constexpr bool value = decltype( test<F>( 0 ) )::value;
+    };
+} // namespace detail
+
+template< class Signature >
+class function_ref;
+
+// function_ref: observer of a callable with signature R( Args... ): a lambda or other
+// function object, a function, or a member function bound to an observed object. It holds
+// the address of the callable, or the function pointer, and the address of a function that
+// calls it: two words, trivially copyable, and never allocating. As any observer, it must not
+// outlive what it observes, e.g. a lambda that is a temporary of the full-expression.
+
+template< class R, class... Args >
+class function_ref< R( Args... ) >
+{
+public:
+    // Observe function object f:
+
+    template< class F, class = typename std::enable_if<
+        !std::is_same< typename std::decay<F>::type, function_ref >::value &&
+        !std::is_function< typename std::remove_reference<F>::type >::value &&
+        !std::is_pointer< typename std::decay<F>::type >::value &&
+        detail::is_callable_r< typename std::remove_reference<F>::type, R, Args... >::value >::type >
+    function_ref( F && f ) nsop_noexcept
+    : callable( make_object( std::addressof( f ) ) )
+    , thunk( &call_object< typename std::remove_reference<F>::type > ) {}
+
+    // Refer to function f:
+
+    template< class F, class = typename std::enable_if<
+        std::is_function<F>::value && detail::is_callable_r< F *, R, Args... >::value >::type >
+    function_ref( F * f ) nsop_noexcept
+    : callable( make_function( f ) )
+    , thunk( &call_function<F> ) {}
+
+    // Bind member function m to the object p observes:
+
+    template< class M, M m, class T >
+    function_ref( member_t<M, m>, observer_ptr<T> p ) nsop_noexcept
+    : callable( make_object( p.get() ) )
+    , thunk( &call_member<M, m, T> ) {}
+
+    R operator()( Args... args ) const
+    {
+        return thunk( callable, std::forward<Args>( args )... );
+    }
+
+    void swap( function_ref & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( callable, other.callable );
+        swap( thunk, other.thunk );
+    }
+
+private:
+    union storage
+    {
+        void * object;
+        void ( * function )();
+    };
+
+    static storage make_object( void const volatile * p ) nsop_noexcept
+    {
+        storage s;
+        s.object = const_cast<void *>( p );
+        return s;
+    }
+
+    template< class F >
+    static storage make_function( F * f ) nsop_noexcept
+    {
+        storage s;
+        s.function = reinterpret_cast< void (*)() >( f );
+        return s;
+    }
+
+    template< class F >
+    static R call_object( storage s, Args... args )
+    {
+        return static_cast<R>( ( *static_cast<F *>( s.object ) )( std::forward<Args>( args )... ) );
+    }
+
+    template< class F >
+    static R call_function( storage s, Args... args )
+    {
+        return static_cast<R>( reinterpret_cast<F *>( s.function )( std::forward<Args>( args )... ) );
+    }
+
+    template< class M, M m, class T >
+    static R call_member( storage s, Args... args )
+    {
+        return static_cast<R>( ( static_cast<T *>( s.object )->*m )( std::forward<Args>( args )... ) );
+    }
+
+    storage callable;
+    R ( * thunk )( storage, Args... );
+};
+
+// specialized algorithms:
+
+template< class Signature >
+void swap( function_ref<Signature> & f1, function_ref<Signature> & f2 ) nsop_noexcept
+{
+    f1.swap( f2 );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::function_ref;
+using observer_ptr_lite::member_t;
+
+#if nsop_CPP17_OR_GREATER
+using observer_ptr_lite::member;
+#endif
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_FUNCTION_H_INCLUDED
+
+// end of file
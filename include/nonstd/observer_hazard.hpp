@@ -0,0 +1,365 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::hazard_domain and nonstd::hazard_guard<>: hazard pointers that hand out observer_ptrs, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_HAZARD_H_INCLUDED
+#define NONSTD_OBSERVER_HAZARD_H_INCLUDED
+
+#include "observer_atomic.hpp"
+#include "observer_reclaim.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+// Number of hazard slots per thread and domain; a thread that holds more guards
+// of a domain at the same time borrows additional slots from the domain:
+
+#ifndef  nsop_CONFIG_HAZARD_SLOTS_PER_THREAD
+# define nsop_CONFIG_HAZARD_SLOTS_PER_THREAD  4
+#endif
+
+// Number of retired objects per thread that triggers reclamation, at least twice
+// the total number of hazard slots:
+
+#ifndef  nsop_CONFIG_HAZARD_RETIRE_THRESHOLD
+# define nsop_CONFIG_HAZARD_RETIRE_THRESHOLD  64
+#endif
+
+// Number of domains per thread with cached hazard slots:
+
+#ifndef  nsop_CONFIG_HAZARD_DOMAINS_PER_THREAD
+# define nsop_CONFIG_HAZARD_DOMAINS_PER_THREAD  4
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // hazard_record: the hazard slots and the retired objects of one thread in one domain.
+    // The slots share a cache line with the list links, the data private to the owning
+    // thread starts the next.
+
+    struct alignas( nsop_CONFIG_CACHE_LINE_SIZE ) hazard_record : thread_record< hazard_record >
+    {
+        enum { slots = nsop_CONFIG_HAZARD_SLOTS_PER_THREAD };
+        enum { all_slots = ( 1u << slots ) - 1 };
+
+        static_assert( slots >= 1 && slots < 32, "nsop_CONFIG_HAZARD_SLOTS_PER_THREAD must be in [1..31]" );
+
+        std::atomic<void const *> slot[ slots ];
+
+        alignas( nsop_CONFIG_CACHE_LINE_SIZE )
+        unsigned                    used;
+        std::vector<retired_object> retired;
+
+        hazard_record() nsop_noexcept
+        : used( 0 )
+        {
+            for ( auto & s : slot )
+            {
+                s.store( nsop_NULLPTR, std::memory_order_relaxed );
+            }
+        }
+
+        unsigned acquire_slot() nsop_noexcept
+        {
+            unsigned index = 0;
+            while ( used & ( 1u << index ) )
+            {
+                ++index;
+            }
+            used |= 1u << index;
+            return index;
+        }
+
+        void release_slot( unsigned index ) nsop_noexcept
+        {
+            slot[ index ].store( nsop_NULLPTR, std::memory_order_release );
+            used &= ~( 1u << index );
+        }
+    };
+} // namespace detail
+
+class hazard_domain;
+
+// hazard_guard: protects the object it observes from reclamation while the guard lives.
+// A guard must be destroyed by the thread that created it.
+
+template< class T >
+class hazard_guard
+{
+public:
+    typedef T   element_type;
+    typedef T * pointer;
+    typedef T & reference;
+
+    hazard_guard( hazard_guard && other ) nsop_noexcept
+    : ptr( other.ptr ), record( other.record ), index( other.index ), temporary( other.temporary )
+    {
+        other.ptr    = nsop_NULLPTR;
+        other.record = nsop_NULLPTR;
+    }
+
+    hazard_guard & operator=( hazard_guard && other ) nsop_noexcept
+    {
+        if ( this != &other )
+        {
+            reset();
+            ptr       = other.ptr;
+            record    = other.record;
+            index     = other.index;
+            temporary = other.temporary;
+            other.ptr    = nsop_NULLPTR;
+            other.record = nsop_NULLPTR;
+        }
+        return *this;
+    }
+
+    hazard_guard( hazard_guard const & ) = delete;
+    hazard_guard & operator=( hazard_guard const & ) = delete;
+
+    ~hazard_guard()
+    {
+        reset();
+    }
+
+    observer_ptr<T> get() const nsop_noexcept
+    {
+        return observer_ptr<T>( ptr );
+    }
+
+    reference operator*() const
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return *ptr;
+    }
+
+    pointer operator->() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return ptr;
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return ptr != nsop_NULLPTR;
+    }
+
+    operator observer_ptr<T>() const nsop_noexcept
+    {
+        return get();
+    }
+
+    // End the protection before the guard goes out of scope:
+
+    void reset() nsop_noexcept
+    {
+        if ( record )
+        {
+            record->release_slot( index );
+
+            if ( temporary )
+                detail::release_record( record );
+        }
+        ptr    = nsop_NULLPTR;
+        record = nsop_NULLPTR;
+    }
+
+private:
+    friend class hazard_domain;
+
+    hazard_guard( pointer p, detail::hazard_record * rec, unsigned idx, bool temp ) nsop_noexcept
+    : ptr( p ), record( rec ), index( idx ), temporary( temp ) {}
+
+    pointer                 ptr;
+    detail::hazard_record * record;
+    unsigned                index;
+    bool                    temporary;
+};
+
+// hazard_domain: hands out hazard_guards and reclaims retired objects that no guard protects.
+// Objects are reclaimed in batches, when the retiring thread has accumulated enough of them.
+// A domain must outlive its guards and must not be in use when it is destroyed.
+
+class hazard_domain
+{
+public:
+    explicit hazard_domain( std::size_t retire_threshold = nsop_CONFIG_HAZARD_RETIRE_THRESHOLD )
+    : threshold( retire_threshold ) {}
+
+    hazard_domain( hazard_domain const & ) = delete;
+    hazard_domain & operator=( hazard_domain const & ) = delete;
+
+    // Reclaim all retired objects; records owned by threads are left for them to delete:
+
+    ~hazard_domain()
+    {
+        for ( detail::hazard_record * rec = records.first(); rec; rec = rec->next )
+        {
+            for ( auto & r : rec->retired )
+            {
+                r.reclaim( r.object );
+            }
+            rec->retired.clear();
+        }
+    }
+
+    // Protect the object the source observes, re-reading the source until it is stable:
+
+    template< class T >
+    hazard_guard<T> protect( atomic_observer_ptr<T> const & src )
+    {
+        return protect_with<T>( [&src]( std::memory_order order ) { return src.load( order ).get(); } );
+    }
+
+    template< class T >
+    hazard_guard<T> protect( std::atomic<T *> const & src )
+    {
+        return protect_with<T>( [&src]( std::memory_order order ) { return src.load( order ); } );
+    }
+
+    // Retire an object that is no longer reachable from the sources; D is default-constructed
+    // to reclaim it once no guard protects it. Retire the object via the same pointer type as
+    // it is protected with:
+
+    template< class T, class D = std::default_delete<T> >
+    void retire( T * p, D = D() )
+    {
+        if ( p == nsop_NULLPTR )
+            return;
+
+        bool temporary = false;
+        detail::hazard_record * const rec = records.thread_record( temporary );
+
+        rec->retired.push_back( detail::make_retired<T, D>( p ) );
+
+        if ( rec->retired.size() >= retire_limit() )
+            scan( rec );
+
+        if ( temporary )
+            detail::release_record( rec );
+    }
+
+    // Reclaim the objects retired by this thread that no guard protects:
+
+    void reclaim()
+    {
+        bool temporary = false;
+        detail::hazard_record * const rec = records.thread_record( temporary );
+
+        scan( rec );
+
+        if ( temporary )
+            detail::release_record( rec );
+    }
+
+private:
+    template< class T, class Load >
+    hazard_guard<T> protect_with( Load load )
+    {
+        bool temporary = false;
+        detail::hazard_record * rec = records.thread_record( temporary );
+
+        if ( !temporary && rec->used == detail::hazard_record::all_slots )
+        {
+            rec = records.acquire();
+            temporary = true;
+        }
+
+        unsigned const index = rec->acquire_slot();
+        std::atomic<void const *> & slot = rec->slot[ index ];
+
+        T * p = load( std::memory_order_relaxed );
+
+        // The re-read must not move before the publication of the hazard, which an acquire
+        // load may do; both are seq_cst, so that the scan either sees the hazard or the
+        // re-read sees the new value of the source:
+
+        for (;;)
+        {
+            slot.store( p, std::memory_order_seq_cst );
+            T * const q = load( std::memory_order_seq_cst );
+
+            if ( q == p )
+                break;
+
+            p = q;
+        }
+
+        return hazard_guard<T>( p, rec, index, temporary );
+    }
+
+    std::size_t retire_limit() const nsop_noexcept
+    {
+        return (std::max)( threshold, 2 * std::size_t( detail::hazard_record::slots ) * records.size() );
+    }
+
+    // Reclaim the retired objects of the record that are not in any hazard slot:
+
+    void scan( detail::hazard_record * rec )
+    {
+        std::atomic_thread_fence( std::memory_order_seq_cst );
+
+        std::vector<void const *> hazards;
+
+        for ( detail::hazard_record * r = records.first(); r; r = r->next )
+        {
+            for ( auto & s : r->slot )
+            {
+                if ( void const * const p = s.load( std::memory_order_acquire ) )
+                    hazards.push_back( p );
+            }
+        }
+
+        std::sort( hazards.begin(), hazards.end(), std::less<void const *>() );
+
+        // Reclaiming may retire further objects:
+
+        std::vector<detail::retired_object> candidates;
+        candidates.swap( rec->retired );
+
+        for ( auto & r : candidates )
+        {
+            if ( std::binary_search( hazards.begin(), hazards.end(), r.object, std::less<void const *>() ) )
+                rec->retired.push_back( r );
+            else
+                r.reclaim( r.object );
+        }
+    }
+
+    detail::record_list< detail::hazard_record, nsop_CONFIG_HAZARD_DOMAINS_PER_THREAD > records;
+    std::size_t const threshold;
+};
+
+// The domain for general use:
+
+inline hazard_domain & default_hazard_domain()
+{
+    static hazard_domain domain;
+    return domain;
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::hazard_guard;
+using observer_ptr_lite::hazard_domain;
+using observer_ptr_lite::default_hazard_domain;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_HAZARD_H_INCLUDED
+
+// end of file
@@ -0,0 +1,195 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::chase_interleaved(): interleaved traversal of chains of observers via C++20 coroutines, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_INTERLEAVE_H_INCLUDED
+#define NONSTD_OBSERVER_INTERLEAVE_H_INCLUDED
+
+#include "observer_prefetch.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <iterator>
+
+// Number of chains that are traversed at the same time:
+
+#ifndef  nsop_CONFIG_INTERLEAVE_WIDTH
+# define nsop_CONFIG_INTERLEAVE_WIDTH  16
+#endif
+
+// Presence of C++20 coroutines:
+
+#if nsop_CPP20_OR_GREATER && defined(__cpp_impl_coroutine) && defined(__has_include)
+# if __has_include( <coroutine> )
+#  define nsop_HAVE_COROUTINES  1
+# endif
+#endif
+
+#ifndef  nsop_HAVE_COROUTINES
+# define nsop_HAVE_COROUTINES  0
+#endif
+
+#if nsop_HAVE_COROUTINES
+# include <coroutine>
+# include <exception>
+# include <utility>
+# include <vector>
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+#if nsop_HAVE_COROUTINES
+
+namespace detail
+{
+    // chase_task: a coroutine that starts suspended and that is resumed by chase_interleaved():
+
+    class chase_task
+    {
+    public:
+        struct promise_type
+        {
+            chase_task get_return_object() nsop_noexcept
+            {
+                return chase_task( std::coroutine_handle<promise_type>::from_promise( *this ) );
+            }
+
+            std::suspend_always initial_suspend() const nsop_noexcept { return {}; }
+            std::suspend_always final_suspend()   const nsop_noexcept { return {}; }
+
+            void return_void() const nsop_noexcept {}
+
+            void unhandled_exception() nsop_noexcept
+            {
+                exception = std::current_exception();
+            }
+
+            std::exception_ptr exception;
+        };
+
+        explicit chase_task( std::coroutine_handle<promise_type> h ) nsop_noexcept
+        : handle( h ) {}
+
+        chase_task( chase_task && other ) nsop_noexcept
+        : handle( std::exchange( other.handle, nullptr ) ) {}
+
+        chase_task( chase_task const & ) = delete;
+        chase_task & operator=( chase_task const & ) = delete;
+
+        ~chase_task()
+        {
+            if ( handle )
+                handle.destroy();
+        }
+
+        bool done() const nsop_noexcept
+        {
+            return handle.done();
+        }
+
+        // Resume until the next suspension; rethrow an exception from the coroutine:
+
+        void resume()
+        {
+            handle.resume();
+
+            if ( handle.done() && handle.promise().exception )
+                std::rethrow_exception( handle.promise().exception );
+        }
+
+    private:
+        std::coroutine_handle<promise_type> handle;
+    };
+
+    // Traverse chains taken from [next, last) one after the other; prefetch each node and
+    // suspend before visiting it, so that the other coroutines run during the cache miss:
+
+    template< class It, class Visit >
+    chase_task chase_chains( It & next, It last, std::size_t & index, Visit & visit )
+    {
+        typedef typename std::iterator_traits<It>::value_type observer_type;
+
+        while ( next != last )
+        {
+            std::size_t const i = index++;
+            observer_type node( *next++ );
+
+            while ( node )
+            {
+                prefetch( node );
+                co_await std::suspend_always();
+                node = visit( i, node );
+            }
+        }
+    }
+} // namespace detail
+
+#endif // nsop_HAVE_COROUTINES
+
+// chase_interleaved: traverse the chains that start at the observers in [first, last).
+// For the i-th chain, visit( i, node ) is called for each node and returns the observer
+// of the next node to visit, or a null observer to end the chain. With C++20 coroutines,
+// width chains are traversed at the same time, so that their cache misses overlap.
+// Without, the chains are traversed one after the other. The nodes of a chain are visited
+// in order; the order of visits across chains is unspecified.
+
+template< class It, class Visit >
+void chase_interleaved( It first, It last, Visit visit, std::size_t width = nsop_CONFIG_INTERLEAVE_WIDTH )
+{
+#if nsop_HAVE_COROUTINES
+    std::size_t const count = width != 0 ? width : 1;
+    std::size_t index = 0;
+    std::vector< detail::chase_task > tasks;
+
+    tasks.reserve( count );
+
+    for ( std::size_t k = 0; k != count; ++k )
+    {
+        tasks.push_back( detail::chase_chains( first, last, index, visit ) );
+    }
+
+    for ( std::size_t live = count; live != 0; )
+    {
+        for ( detail::chase_task & task : tasks )
+        {
+            if ( task.done() )
+                continue;
+
+            task.resume();
+
+            if ( task.done() )
+                --live;
+        }
+    }
+#else
+    typedef typename std::iterator_traits<It>::value_type observer_type;
+
+    (void) width;
+
+    for ( std::size_t i = 0; first != last; ++first, ++i )
+    {
+        for ( observer_type node( *first ); node; node = visit( i, node ) ) {}
+    }
+#endif
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::chase_interleaved;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_INTERLEAVE_H_INCLUDED
+
+// end of file
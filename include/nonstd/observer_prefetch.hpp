@@ -0,0 +1,225 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::prefetch() and nonstd::prefetch_iterator<>: prefetch the objects observers observe, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_PREFETCH_H_INCLUDED
+#define NONSTD_OBSERVER_PREFETCH_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+
+// Number of elements a prefetch_iterator prefetches ahead of the current one:
+
+#ifndef  nsop_CONFIG_PREFETCH_DISTANCE
+# define nsop_CONFIG_PREFETCH_DISTANCE  8
+#endif
+
+// Prefetch instruction: GNU and Clang builtin, SSE intrinsic for MSVC on x86, else none:
+
+#if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+# define nsop_HAVE_PREFETCH_BUILTIN  1
+#elif nsop_COMPILER_MSVC_VER && ( defined(_M_IX86) || defined(_M_X64) )
+# define nsop_HAVE_PREFETCH_MM  1
+# include <xmmintrin.h>
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+// Intended access of the prefetched object:
+
+enum class prefetch_access
+{
+    read  = 0,
+    write = 1,
+};
+
+// Expected temporal locality, from none (use once) to high (keep in all cache levels):
+
+enum class prefetch_locality
+{
+    none     = 0,
+    low      = 1,
+    moderate = 2,
+    high     = 3,
+};
+
+namespace detail
+{
+    template< prefetch_access A, prefetch_locality L >
+    inline void prefetch_address( void const * p ) nsop_noexcept
+    {
+#if defined( nsop_HAVE_PREFETCH_BUILTIN )
+        __builtin_prefetch( p, static_cast<int>( A ), static_cast<int>( L ) );
+#elif defined( nsop_HAVE_PREFETCH_MM )
+        _mm_prefetch( static_cast<char const *>( p ),
+              L == prefetch_locality::high     ? _MM_HINT_T0
+            : L == prefetch_locality::moderate ? _MM_HINT_T1
+            : L == prefetch_locality::low      ? _MM_HINT_T2 : _MM_HINT_NTA );
+#else
+        (void) p;
+#endif
+    }
+} // namespace detail
+
+// prefetch: hint the processor to load the object an observer or a pointer refers to into
+// the cache. Prefetching a null observer is harmless.
+
+template< prefetch_access A = prefetch_access::read, prefetch_locality L = prefetch_locality::high, class P >
+inline void prefetch( P const & p ) nsop_noexcept
+{
+    detail::prefetch_address<A, L>( detail::observed_address( p ) );
+}
+
+// prefetch_iterator: forward iterator over a sequence of observers or pointers that, while
+// advancing, prefetches the object that the element a given distance ahead observes.
+// The distance is limited by the end of the sequence; distance 0 prefetches nothing.
+
+template< class It, prefetch_access A = prefetch_access::read, prefetch_locality L = prefetch_locality::high >
+class prefetch_iterator
+{
+public:
+    typedef std::forward_iterator_tag                             iterator_category;
+    typedef typename std::iterator_traits<It>::value_type         value_type;
+    typedef typename std::iterator_traits<It>::difference_type    difference_type;
+    typedef typename std::iterator_traits<It>::pointer            pointer;
+    typedef typename std::iterator_traits<It>::reference          reference;
+
+    prefetch_iterator()
+    : cur(), ahead(), last() {}
+
+    // Iterator to the end of the sequence:
+
+    explicit prefetch_iterator( It last_ )
+    : cur( last_ ), ahead( last_ ), last( last_ ) {}
+
+    // Iterator to the begin of [first, last), that prefetches the first distance elements;
+    // without distance, ahead starts at the end, so that advancing does not prefetch:
+
+    prefetch_iterator( It first, It last_, std::size_t distance = nsop_CONFIG_PREFETCH_DISTANCE )
+    : cur( first ), ahead( distance != 0 ? first : last_ ), last( last_ )
+    {
+        for ( ; distance != 0 && ahead != last; --distance, ++ahead )
+        {
+            prefetch<A, L>( *ahead );
+        }
+    }
+
+    It base() const
+    {
+        return cur;
+    }
+
+    reference operator*() const
+    {
+        return *cur;
+    }
+
+    pointer operator->() const
+    {
+        return std::addressof( *cur );
+    }
+
+    prefetch_iterator & operator++()
+    {
+        ++cur;
+
+        if ( ahead != last )
+        {
+            prefetch<A, L>( *ahead );
+            ++ahead;
+        }
+        return *this;
+    }
+
+    prefetch_iterator operator++( int )
+    {
+        prefetch_iterator result( *this );
+        ++*this;
+        return result;
+    }
+
+    friend bool operator==( prefetch_iterator const & a, prefetch_iterator const & b )
+    {
+        return a.cur == b.cur;
+    }
+
+    friend bool operator!=( prefetch_iterator const & a, prefetch_iterator const & b )
+    {
+        return !( a == b );
+    }
+
+private:
+    It cur;
+    It ahead;
+    It last;
+};
+
+// prefetch_range: a range of prefetch_iterators, for use in a range-based for loop:
+
+template< class It, prefetch_access A = prefetch_access::read, prefetch_locality L = prefetch_locality::high >
+class prefetch_range
+{
+public:
+    typedef prefetch_iterator<It, A, L> iterator;
+
+    prefetch_range( It first_, It last_, std::size_t distance_ = nsop_CONFIG_PREFETCH_DISTANCE )
+    : first( first_ ), last( last_ ), distance( distance_ ) {}
+
+    iterator begin() const
+    {
+        return iterator( first, last, distance );
+    }
+
+    iterator end() const
+    {
+        return iterator( last );
+    }
+
+private:
+    It          first;
+    It          last;
+    std::size_t distance;
+};
+
+template< prefetch_access A = prefetch_access::read, prefetch_locality L = prefetch_locality::high, class C >
+auto make_prefetch_range( C & c, std::size_t distance = nsop_CONFIG_PREFETCH_DISTANCE )
+    -> prefetch_range<decltype( std::begin( c ) ), A, L>
+{
+    return prefetch_range<decltype( std::begin( c ) ), A, L>( std::begin( c ), std::end( c ), distance );
+}
+
+template< prefetch_access A = prefetch_access::read, prefetch_locality L = prefetch_locality::high, class It >
+prefetch_range<It, A, L> make_prefetch_range( It first, It last, std::size_t distance = nsop_CONFIG_PREFETCH_DISTANCE )
+{
+    return prefetch_range<It, A, L>( first, last, distance );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::prefetch_access;
+using observer_ptr_lite::prefetch_locality;
+using observer_ptr_lite::prefetch;
+using observer_ptr_lite::prefetch_iterator;
+using observer_ptr_lite::prefetch_range;
+using observer_ptr_lite::make_prefetch_range;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_PREFETCH_H_INCLUDED
+
+// end of file
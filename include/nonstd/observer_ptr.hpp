@@ -41,6 +41,18 @@
 # define nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_TO_UNDERLYING_TYPE  0
 #endif
 
+#ifndef  nsop_CONFIG_DEREF_CHECK
+# define nsop_CONFIG_DEREF_CHECK  nsop_DEREF_CHECK_ASSERT
+#endif
+
+#ifndef  nsop_CONFIG_TAGGED_POINTER_HIGH_BITS
+# define nsop_CONFIG_TAGGED_POINTER_HIGH_BITS  nsop_POINTER_HIGH_BITS
+#endif
+
+#ifndef  nsop_CONFIG_MIXING_HASH
+# define nsop_CONFIG_MIXING_HASH  0
+#endif
+
 #ifndef  nsop_CONFIG_CONFIRMS_COMPILATION_ERRORS
 # define nsop_CONFIG_CONFIRMS_COMPILATION_ERRORS  0
 #endif
@@ -49,6 +61,12 @@
 #define nsop_OBSERVER_PTR_NONSTD   1
 #define nsop_OBSERVER_PTR_STD      2
 
+#define nsop_DEREF_CHECK_NONE      0
+#define nsop_DEREF_CHECK_ASSERT    1
+#define nsop_DEREF_CHECK_TRAP      2
+#define nsop_DEREF_CHECK_THROW     3
+#define nsop_DEREF_CHECK_HANDLER   4
+
 #if !defined( nsop_CONFIG_SELECT_OBSERVER_PTR )
 # define nsop_CONFIG_SELECT_OBSERVER_PTR  ( nsop_HAVE_STD_OBSERVER_PTR ? nsop_OBSERVER_PTR_STD : nsop_OBSERVER_PTR_NONSTD )
 #endif
@@ -86,30 +104,6 @@
 
 #define  nsop_USES_STD_OBSERVER_PTR  ( (nsop_CONFIG_SELECT_OBSERVER_PTR == nsop_OBSERVER_PTR_STD) || ((nsop_CONFIG_SELECT_OBSERVER_PTR == nsop_OBSERVER_PTR_DEFAULT) && nsop_HAVE_STD_OBSERVER_PTR) )
 
-//
-// Using std::experimental::observer_ptr:
-//
-
-#if nsop_USES_STD_OBSERVER_PTR
-
-#include <experimental/memory>
-
-namespace nonstd {
-
-    using std::experimental::observer_ptr;
-    using std::experimental::make_observer;
-    using std::experimental::swap;
-
-    using std::experimental::operator==;
-    using std::experimental::operator!=;
-    using std::experimental::operator<;
-    using std::experimental::operator<=;
-    using std::experimental::operator>;
-    using std::experimental::operator>=;
-}
-
-#else // nsop_USES_STD_OBSERVER_PTR
-
 #include <cassert>
 #include <algorithm>
 #include <functional>
@@ -188,11 +182,23 @@ namespace nonstd {
 
 #define nsop_HAVE_TYPEOF  (nsop_CPP11_000 && nsop_COMPILER_GNUC_VERSION)
 
+// Unused upper bits of a pointer, given 48-bit virtual addresses on x86-64 and AArch64:
+
+#if ( defined(__x86_64__) && !defined(__ILP32__) ) || defined(_M_X64) || defined(__aarch64__) || defined(_M_ARM64)
+# define nsop_POINTER_HIGH_BITS  16
+#else
+# define nsop_POINTER_HIGH_BITS  0
+#endif
+
 // Presence of C++ library features:
 
 #define nsop_HAVE_STD_DECAY             nsop_CPP11_110
 #define nsop_HAVE_STD_DECLVAL           nsop_CPP11_110
-#define nsop_HAVE_STD_SMART_PTRS        nsop_CPP11_140
+
+// Implicit conversion from std smart pointers is an extension of nonstd::observer_ptr;
+// std::experimental::observer_ptr does not provide it:
+
+#define nsop_HAVE_STD_SMART_PTRS        ( nsop_CPP11_140 && !nsop_USES_STD_OBSERVER_PTR )
 
 // Presence and usage of smart pointers:
 
@@ -234,12 +240,118 @@ namespace nonstd {
 # define nsop_NULLPTR NULL
 #endif
 
+// Branch prediction hint:
+
+#if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+# define nsop_LIKELY( expr )  __builtin_expect( !!( expr ), 1 )
+#else
+# define nsop_LIKELY( expr )  ( expr )
+#endif
+
+#if defined(__has_cpp_attribute) && nsop_CPP20_OR_GREATER
+# if __has_cpp_attribute( unlikely )
+#  define nsop_HAVE_ATTRIBUTE_UNLIKELY  1
+# endif
+#endif
+
+#if defined(nsop_HAVE_ATTRIBUTE_UNLIKELY)
+# define nsop_UNLIKELY( expr )  ( expr ) [[unlikely]]
+#elif nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+# define nsop_UNLIKELY( expr )  ( __builtin_expect( !!( expr ), 0 ) )
+#else
+# define nsop_UNLIKELY( expr )  ( expr )
+#endif
+
+// Optimizer assumption:
+
+#if defined(__has_cpp_attribute) && nsop_CPP23_OR_GREATER
+# if __has_cpp_attribute( assume )
+#  define nsop_HAVE_ATTRIBUTE_ASSUME  1
+# endif
+#endif
+
+#if defined(nsop_HAVE_ATTRIBUTE_ASSUME)
+# define nsop_ASSUME( expr )  [[assume( expr )]]
+#elif nsop_COMPILER_CLANG_VERSION
+# define nsop_ASSUME( expr )  __builtin_assume( expr )
+#elif nsop_COMPILER_MSVC_VER
+# define nsop_ASSUME( expr )  __assume( expr )
+#elif nsop_COMPILER_GNUC_VERSION
+# define nsop_ASSUME( expr )  ( ( expr ) ? static_cast<void>( 0 ) : __builtin_unreachable() )
+#else
+# define nsop_ASSUME( expr )  static_cast<void>( 0 )
+#endif
+
+// Function that never returns a null pointer:
+
+#if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+# define nsop_ATTRIBUTE_RETURNS_NONNULL  __attribute__((returns_nonnull))
+#else
+# define nsop_ATTRIBUTE_RETURNS_NONNULL  /*nothing*/
+#endif
+
+// Function that never returns:
+
+#if nsop_CPP11_OR_GREATER
+# define nsop_NORETURN  [[noreturn]]
+#elif nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+# define nsop_NORETURN  __attribute__((noreturn))
+#elif nsop_COMPILER_MSVC_VER
+# define nsop_NORETURN  __declspec(noreturn)
+#else
+# define nsop_NORETURN  /*nothing*/
+#endif
+
+// Pointer qualifier that promises no aliasing, as C99 restrict:
+
+#if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION || nsop_COMPILER_MSVC_VER >= 1400
+# define nsop_RESTRICT  __restrict
+#else
+# define nsop_RESTRICT  /*nothing*/
+#endif
+
+// Dereference check of an observer, per nsop_CONFIG_DEREF_CHECK; used as a statement:
+
+#if   nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_NONE
+# define nsop_DEREF_CHECK( valid )  nsop_ASSUME( valid )
+#elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_ASSERT
+# define nsop_DEREF_CHECK( valid )  assert( valid )
+#elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_TRAP
+# if nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_CLANG_VERSION
+#  define nsop_DEREF_CHECK( valid )  do { if nsop_UNLIKELY( !( valid ) ) { __builtin_trap(); } } while ( false )
+# else
+#  include <cstdlib>
+#  define nsop_DEREF_CHECK( valid )  do { if nsop_UNLIKELY( !( valid ) ) { std::abort(); } } while ( false )
+# endif
+#elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+# include <stdexcept>
+# define nsop_DEREF_CHECK( valid )  do { if nsop_UNLIKELY( !( valid ) ) { throw ::nonstd::bad_observer_access(); } } while ( false )
+#elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+# define nsop_DEREF_CHECK( valid )  do { if nsop_UNLIKELY( !( valid ) ) { ::nonstd::deref_check_handler(); } } while ( false )
+#else
+# error nsop_CONFIG_DEREF_CHECK: expected one of nsop_DEREF_CHECK_NONE, _ASSERT, _TRAP, _THROW or _HANDLER
+#endif
+
+// A dereference may throw if the check throws or calls a user-provided handler:
+
+#if nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW || nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+# define nsop_deref_noexcept /*nothing*/
+#else
+# define nsop_deref_noexcept nsop_noexcept
+#endif
+
 // additional includes:
 
 #if nsop_HAVE_IMPLICIT_CONVERSION_FROM_SMART_PTR
 # include <memory>
 #endif
 
+#if nsop_CPP11_OR_GREATER
+# include <cstddef>
+# include <cstdint>
+# include <type_traits>
+#endif
+
 // common_type:
 
 #if nsop_HAVE_STD_DECAY && nsop_HAVE_STD_DECLVAL
@@ -255,6 +367,118 @@ namespace nonstd {
 #define nsop_REQUIRES_T(VA) \
     , typename std::enable_if< (VA), int >::type = 0
 
+// Composite pointer type, for ordered comparison of observers of related types:
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    template< class T, class U >
+#if nsop_HAVE_OWN_COMMON_TYPE_STD
+    struct common_type { typedef typename std::decay< decltype(true ? std::declval<T>() : std::declval<U>()) >::type type; };
+#elif nsop_HAVE_OWN_COMMON_TYPE_TYPEOF
+    struct common_type { typedef __typeof__( true ? T() : U() ) type; };
+#else // fall back
+    struct common_type { typedef T type; };
+#endif
+
+#if nsop_CPP11_OR_GREATER
+
+    // Number of low bits that are zero in a pointer aligned to n bytes:
+
+    inline constexpr unsigned alignment_bits( std::size_t n ) nsop_noexcept
+    {
+        return n < 2 ? 0 : 1 + alignment_bits( n / 2 );
+    }
+
+    // Alignment of the object a T* points to; 1 for void and for functions:
+
+    template< class T >
+    struct address_alignment : std::integral_constant< std::size_t,
+        alignof( typename std::conditional< std::is_object<T>::value, T, char >::type ) > {};
+
+    // Mixing hash of an address: drop the low bits that are zero due to the alignment of T,
+    // multiply by 2^64 divided by the golden ratio and fold the high half of the product,
+    // that depends on all address bits, onto the low half, that a table of 2^n buckets uses:
+
+    template< class T >
+    inline std::size_t mix_address( T * p ) nsop_noexcept
+    {
+        std::uint64_t const h = ( static_cast<std::uint64_t>( reinterpret_cast<std::uintptr_t>( p ) )
+            >> alignment_bits( address_alignment<T>::value ) ) * 0x9E3779B97F4A7C15ull;
+
+        return static_cast<std::size_t>( h ^ ( h >> 32 ) );
+    }
+
+    // Hash of an address for std::hash of the nonstd observers, per nsop_CONFIG_MIXING_HASH:
+
+    template< class T >
+    inline std::size_t hash_address( T * p ) nsop_noexcept
+    {
+#if nsop_CONFIG_MIXING_HASH
+        return mix_address( p );
+#else
+        return std::hash<T *>()( p );
+#endif
+    }
+
+#endif // nsop_CPP11_OR_GREATER
+} // namespace detail
+
+#if nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+
+// bad_observer_access: thrown on dereferencing a null observer:
+
+class bad_observer_access : public std::logic_error
+{
+public:
+    bad_observer_access()
+    : std::logic_error( "observer_ptr: dereference of null observer" ) {}
+};
+
+#endif
+
+} // namespace observer_ptr_lite
+
+#if nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+using observer_ptr_lite::bad_observer_access;
+#endif
+
+#if nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+
+// Called on dereferencing a null observer; to be defined by the user, must not return, but
+// may throw or terminate:
+
+nsop_NORETURN void deref_check_handler();
+
+#endif
+
+} // namespace nonstd
+
+//
+// Using std::experimental::observer_ptr:
+//
+
+#if nsop_USES_STD_OBSERVER_PTR
+
+#include <experimental/memory>
+
+namespace nonstd {
+
+    using std::experimental::observer_ptr;
+    using std::experimental::make_observer;
+    using std::experimental::swap;
+
+    using std::experimental::operator==;
+    using std::experimental::operator!=;
+    using std::experimental::operator<;
+    using std::experimental::operator<=;
+    using std::experimental::operator>;
+    using std::experimental::operator>=;
+}
+
+#else // nsop_USES_STD_OBSERVER_PTR
+
 //
 // oberver_ptr:
 //
@@ -313,11 +537,13 @@ public:
 
     nsop_constexpr14 reference operator*() const
     {
-        return assert( ptr != nsop_NULLPTR ), *ptr;
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return *ptr;
     }
 
-    nsop_constexpr14 pointer operator->() const nsop_noexcept
+    nsop_constexpr14 pointer operator->() const nsop_deref_noexcept
     {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
         return ptr;
     }
 
@@ -344,9 +570,11 @@ private:
     void this_type_does_not_support_comparisons() const {}
 public:
 
+    // Predict non-null as the compiler does for a raw pointer; its heuristic does not apply to safe_bool:
+
     nsop_constexpr14 operator safe_bool() const nsop_noexcept
     {
-        return ptr != nsop_NULLPTR ? &observer_ptr::this_type_does_not_support_comparisons : 0;
+        return nsop_LIKELY( ptr != nsop_NULLPTR ) ? &observer_ptr::this_type_does_not_support_comparisons : 0;
     }
 #endif
 
@@ -425,18 +653,6 @@ bool operator!=( std::nullptr_t, observer_ptr<W> p ) nsop_noexcept
 }
 #endif
 
-namespace detail
-{
-    template< class T, class U >
-#if nsop_HAVE_OWN_COMMON_TYPE_STD
-    struct common_type { typedef typename std::decay< decltype(true ? std::declval<T>() : std::declval<U>()) >::type type; };
-#elif nsop_HAVE_OWN_COMMON_TYPE_TYPEOF
-    struct common_type { typedef __typeof__( true ? T() : U() ) type; };
-#else // fall back
-    struct common_type { typedef T type; };
-#endif
-} // namespace detail
-
 template< class W1, class W2 >
 bool operator<( observer_ptr<W1> p1, observer_ptr<W2> p2 )
 {
@@ -490,17 +706,1131 @@ struct hash< ::nonstd::observer_ptr<T> >
 {
     size_t operator()(::nonstd::observer_ptr<T> p ) const nsop_noexcept
     {
-        return hash<T*>()( p.get() );
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
     }
 };
 
 }
 #endif
 
-// #undef ...
-
 #endif // nsop_USES_STD_OBSERVER_PTR
 
+//
+// observer_ptr extensions, for nonstd::observer_ptr and std::experimental::observer_ptr:
+//
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    inline constexpr unsigned min_bits( unsigned a, unsigned b ) nsop_noexcept
+    {
+        return a < b ? a : b;
+    }
+} // namespace detail
+
+// tagged_observer_ptr: observer that stores a tag of Bits bits in the otherwise unused bits of
+// the pointer, first in the low bits that are zero due to the alignment of W, then, if available,
+// in the upper bits of a 64-bit pointer (nsop_CONFIG_TAGGED_POINTER_HIGH_BITS). The tag does not
+// take part in the access to and the comparison and hashing of the observed pointer.
+
+template< class W, unsigned Bits >
+class tagged_observer_ptr
+{
+public:
+    typedef W   element_type;
+    typedef W * pointer;
+    typedef W & reference;
+    typedef std::uintptr_t tag_type;
+
+    static constexpr unsigned tag_bits  = Bits;
+    static constexpr unsigned low_bits  = detail::min_bits( Bits, detail::alignment_bits( alignof(W) ) );
+    static constexpr unsigned high_bits = Bits - low_bits;
+
+    static_assert( high_bits <= nsop_CONFIG_TAGGED_POINTER_HIGH_BITS,
+        "tagged_observer_ptr: more tag bits than available from alignment of W and unused upper pointer bits" );
+
+    nsop_constexpr tagged_observer_ptr() nsop_noexcept
+    : bits( 0 ) {}
+
+    nsop_constexpr tagged_observer_ptr( std::nullptr_t ) nsop_noexcept
+    : bits( 0 ) {}
+
+    explicit tagged_observer_ptr( pointer p, tag_type t = 0 ) nsop_noexcept
+    : bits( encode( p, t ) ) {}
+
+    explicit tagged_observer_ptr( observer_ptr<W> p, tag_type t = 0 ) nsop_noexcept
+    : bits( encode( p.get(), t ) ) {}
+
+    pointer get() const nsop_noexcept
+    {
+        return high_bits == 0
+            ? reinterpret_cast<pointer>( bits & ~low_mask )
+            : reinterpret_cast<pointer>( static_cast<std::intptr_t>( ( bits & ~low_mask ) << high_bits ) >> high_bits );
+    }
+
+    reference operator*() const
+    {
+        pointer const p = get();
+        nsop_DEREF_CHECK( p != nsop_NULLPTR );
+        return *p;
+    }
+
+    pointer operator->() const nsop_deref_noexcept
+    {
+        pointer const p = get();
+        nsop_DEREF_CHECK( p != nsop_NULLPTR );
+        return p;
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return get() != nsop_NULLPTR;
+    }
+
+    explicit operator pointer() const nsop_noexcept
+    {
+        return get();
+    }
+
+    operator observer_ptr<W>() const nsop_noexcept
+    {
+        return observer_ptr<W>( get() );
+    }
+
+    tag_type tag() const nsop_noexcept
+    {
+        return ( bits & low_mask ) | ( ( bits >> high_shift ) << low_bits & high_mask() );
+    }
+
+    void set_tag( tag_type t ) nsop_noexcept
+    {
+        bits = encode( get(), t );
+    }
+
+    pointer release() nsop_noexcept
+    {
+        pointer p( get() );
+        reset();
+        return p;
+    }
+
+    void reset( pointer p = nsop_NULLPTR, tag_type t = 0 ) nsop_noexcept
+    {
+        bits = encode( p, t );
+    }
+
+    void swap( tagged_observer_ptr & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( bits, other.bits );
+    }
+
+private:
+    static constexpr unsigned pointer_bits = 8 * sizeof( std::uintptr_t );
+    static constexpr unsigned high_shift   = high_bits == 0 ? 0 : pointer_bits - high_bits;
+    static constexpr tag_type low_mask     = ( tag_type( 1 ) << low_bits ) - 1;
+
+    // mask of the tag bits that are stored in the upper pointer bits, in tag position:
+
+    static constexpr tag_type high_mask() nsop_noexcept
+    {
+        return high_bits == 0 ? 0 : ( ( tag_type( 1 ) << high_bits ) - 1 ) << low_bits;
+    }
+
+    static std::uintptr_t encode( pointer p, tag_type t ) nsop_noexcept
+    {
+        return assert( ( t & ~( low_mask | high_mask() ) ) == 0 ),
+            ( reinterpret_cast<std::uintptr_t>( p ) & ( ~std::uintptr_t( 0 ) >> high_bits ) )
+            | ( t & low_mask )
+            | ( ( t & high_mask() ) >> low_bits << high_shift );
+    }
+
+    std::uintptr_t bits;
+};
+
+template< class W, unsigned Bits > constexpr unsigned tagged_observer_ptr<W, Bits>::tag_bits;
+template< class W, unsigned Bits > constexpr unsigned tagged_observer_ptr<W, Bits>::low_bits;
+template< class W, unsigned Bits > constexpr unsigned tagged_observer_ptr<W, Bits>::high_bits;
+
+// specialized algorithms:
+
+template< class W, unsigned Bits >
+void swap( tagged_observer_ptr<W, Bits> & p1, tagged_observer_ptr<W, Bits> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< unsigned Bits, class W >
+tagged_observer_ptr<W, Bits> make_tagged_observer( W * p, typename tagged_observer_ptr<W, Bits>::tag_type t = 0 ) nsop_noexcept
+{
+    return tagged_observer_ptr<W, Bits>( p, t );
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator==( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator!=( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class W, unsigned B >
+bool operator==( tagged_observer_ptr<W, B> p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W, unsigned B >
+bool operator==( std::nullptr_t, tagged_observer_ptr<W, B> p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W, unsigned B >
+bool operator!=( tagged_observer_ptr<W, B> p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W, unsigned B >
+bool operator!=( std::nullptr_t, tagged_observer_ptr<W, B> p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator<( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return std::less< typename detail::common_type<W1*,W2*>::type >()( p1.get(), p2.get() );
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator>( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator<=( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class W1, unsigned B1, class W2, unsigned B2 >
+bool operator>=( tagged_observer_ptr<W1, B1> p1, tagged_observer_ptr<W2, B2> p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+// observer_ptr32: observer that stores the 32-bit offset of the observed object from the
+// base of an arena of less than 4 GiB. Arena provides the base address via its static member
+// function base(). Offset 0 represents the null pointer, an object at offset n is stored as n+1.
+
+template< class W, class Arena >
+class observer_ptr32
+{
+public:
+    typedef W   element_type;
+    typedef W * pointer;
+    typedef W & reference;
+    typedef std::uint32_t offset_type;
+
+    nsop_constexpr observer_ptr32() nsop_noexcept
+    : off( 0 ) {}
+
+    nsop_constexpr observer_ptr32( std::nullptr_t ) nsop_noexcept
+    : off( 0 ) {}
+
+    explicit observer_ptr32( pointer p ) nsop_deref_noexcept
+    : off( encode( p ) ) {}
+
+    explicit observer_ptr32( observer_ptr<W> p ) nsop_deref_noexcept
+    : off( encode( p.get() ) ) {}
+
+    template< class W2
+        nsop_REQUIRES_T(( std::is_convertible<W2*, W*>::value ))
+    >
+    observer_ptr32( observer_ptr32<W2, Arena> other ) nsop_deref_noexcept
+    : off( encode( other.get() ) ) {}
+
+    pointer get() const nsop_noexcept
+    {
+        return off == 0 ? nsop_NULLPTR : reinterpret_cast<pointer>( base() + ( off - 1 ) );
+    }
+
+    reference operator*() const
+    {
+        nsop_DEREF_CHECK( off != 0 );
+        return *get();
+    }
+
+    pointer operator->() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( off != 0 );
+        return get();
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return off != 0;
+    }
+
+    explicit operator pointer() const nsop_noexcept
+    {
+        return get();
+    }
+
+    operator observer_ptr<W>() const nsop_noexcept
+    {
+        return observer_ptr<W>( get() );
+    }
+
+    offset_type offset() const nsop_noexcept
+    {
+        return off;
+    }
+
+    pointer release() nsop_noexcept
+    {
+        pointer p( get() );
+        reset();
+        return p;
+    }
+
+    void reset( pointer p = nsop_NULLPTR ) nsop_deref_noexcept
+    {
+        off = encode( p );
+    }
+
+    void swap( observer_ptr32 & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( off, other.off );
+    }
+
+private:
+    static char * base() nsop_noexcept
+    {
+        return reinterpret_cast<char *>( Arena::base() );
+    }
+
+    static offset_type encode( pointer p ) nsop_deref_noexcept
+    {
+        return p == nsop_NULLPTR ? 0 : encode_offset(
+            reinterpret_cast<std::uintptr_t>( p ) - reinterpret_cast<std::uintptr_t>( base() ) );
+    }
+
+    // An object before the arena or 4 GiB or more into it is checked per nsop_CONFIG_DEREF_CHECK,
+    // as a dereference of a null observer; without the check it is undefined behaviour:
+
+    static offset_type encode_offset( std::uintptr_t n ) nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( n < 0xffffffffu );
+        return static_cast<offset_type>( n + 1 );
+    }
+
+    offset_type off;
+};
+
+// specialized algorithms; offsets order as addresses do, with null first:
+
+template< class W, class Arena >
+void swap( observer_ptr32<W, Arena> & p1, observer_ptr32<W, Arena> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class Arena, class W >
+observer_ptr32<W, Arena> make_observer32( W * p ) nsop_deref_noexcept
+{
+    return observer_ptr32<W, Arena>( p );
+}
+
+template< class W1, class W2, class Arena >
+bool operator==( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return p1.offset() == p2.offset();
+}
+
+template< class W1, class W2, class Arena >
+bool operator!=( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class W, class Arena >
+bool operator==( observer_ptr32<W, Arena> p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W, class Arena >
+bool operator==( std::nullptr_t, observer_ptr32<W, Arena> p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W, class Arena >
+bool operator!=( observer_ptr32<W, Arena> p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W, class Arena >
+bool operator!=( std::nullptr_t, observer_ptr32<W, Arena> p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W1, class W2, class Arena >
+bool operator<( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return p1.offset() < p2.offset();
+}
+
+template< class W1, class W2, class Arena >
+bool operator>( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class W1, class W2, class Arena >
+bool operator<=( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class W1, class W2, class Arena >
+bool operator>=( observer_ptr32<W1, Arena> p1, observer_ptr32<W2, Arena> p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+// offset_observer_ptr: observer that stores the distance from its own address to the observed
+// object, so that a structure of observers and observed objects can be mapped at any address,
+// e.g. in a memory-mapped file or in shared memory. Distance 1 represents the null pointer.
+// Copying recomputes the distance, hence an offset_observer_ptr is not trivially copyable.
+
+template< class W >
+class offset_observer_ptr
+{
+public:
+    typedef W   element_type;
+    typedef W * pointer;
+    typedef W & reference;
+    typedef std::ptrdiff_t offset_type;
+
+    offset_observer_ptr() nsop_noexcept
+    : off( null_offset ) {}
+
+    offset_observer_ptr( std::nullptr_t ) nsop_noexcept
+    : off( null_offset ) {}
+
+    explicit offset_observer_ptr( pointer p ) nsop_noexcept
+    : off( encode( p ) ) {}
+
+    explicit offset_observer_ptr( observer_ptr<W> p ) nsop_noexcept
+    : off( encode( p.get() ) ) {}
+
+    offset_observer_ptr( offset_observer_ptr const & other ) nsop_noexcept
+    : off( encode( other.get() ) ) {}
+
+    template< class W2
+        nsop_REQUIRES_T(( std::is_convertible<W2*, W*>::value ))
+    >
+    offset_observer_ptr( offset_observer_ptr<W2> const & other ) nsop_noexcept
+    : off( encode( other.get() ) ) {}
+
+    offset_observer_ptr & operator=( offset_observer_ptr const & other ) nsop_noexcept
+    {
+        off = encode( other.get() );
+        return *this;
+    }
+
+    pointer get() const nsop_noexcept
+    {
+        return off == null_offset ? nsop_NULLPTR
+            : reinterpret_cast<pointer>( self() + static_cast<std::uintptr_t>( off ) );
+    }
+
+    reference operator*() const
+    {
+        nsop_DEREF_CHECK( off != null_offset );
+        return *get();
+    }
+
+    pointer operator->() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( off != null_offset );
+        return get();
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return off != null_offset;
+    }
+
+    explicit operator pointer() const nsop_noexcept
+    {
+        return get();
+    }
+
+    operator observer_ptr<W>() const nsop_noexcept
+    {
+        return observer_ptr<W>( get() );
+    }
+
+    offset_type offset() const nsop_noexcept
+    {
+        return off;
+    }
+
+    pointer release() nsop_noexcept
+    {
+        pointer p( get() );
+        reset();
+        return p;
+    }
+
+    void reset( pointer p = nsop_NULLPTR ) nsop_noexcept
+    {
+        off = encode( p );
+    }
+
+    void swap( offset_observer_ptr & other ) nsop_noexcept
+    {
+        pointer p( get() );
+        reset( other.get() );
+        other.reset( p );
+    }
+
+private:
+    static constexpr offset_type null_offset = 1;
+
+    std::uintptr_t self() const nsop_noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>( this );
+    }
+
+    offset_type encode( pointer p ) const nsop_noexcept
+    {
+        return p == nsop_NULLPTR ? null_offset
+            : static_cast<offset_type>( reinterpret_cast<std::uintptr_t>( p ) - self() );
+    }
+
+    offset_type off;
+};
+
+// specialized algorithms:
+
+template< class W >
+void swap( offset_observer_ptr<W> & p1, offset_observer_ptr<W> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class W1, class W2 >
+bool operator==( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class W1, class W2 >
+bool operator!=( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class W >
+bool operator==( offset_observer_ptr<W> const & p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W >
+bool operator==( std::nullptr_t, offset_observer_ptr<W> const & p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W >
+bool operator!=( offset_observer_ptr<W> const & p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W >
+bool operator!=( std::nullptr_t, offset_observer_ptr<W> const & p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W1, class W2 >
+bool operator<( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return std::less< typename detail::common_type<W1*,W2*>::type >()( p1.get(), p2.get() );
+}
+
+template< class W1, class W2 >
+bool operator>( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class W1, class W2 >
+bool operator<=( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class W1, class W2 >
+bool operator>=( offset_observer_ptr<W1> const & p1, offset_observer_ptr<W2> const & p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+// nonnull_observer_ptr: observer that never is null. Construction from a pointer or from an
+// observer_ptr checks for null per nsop_CONFIG_DEREF_CHECK; from then on the compiler is told
+// that get() is not null, so that null checks downstream, also of an observer_ptr converted
+// from it, can be removed. There is no default construction, no conversion to bool, no
+// comparison to nullptr and no release().
+
+template< class W >
+class nonnull_observer_ptr
+{
+public:
+    typedef W   element_type;
+    typedef W * pointer;
+    typedef W & reference;
+
+    nonnull_observer_ptr() = delete;
+    nonnull_observer_ptr( std::nullptr_t ) = delete;
+
+    explicit nonnull_observer_ptr( pointer p ) nsop_deref_noexcept
+    : ptr( p )
+    {
+        nsop_DEREF_CHECK( p != nsop_NULLPTR );
+    }
+
+    explicit nonnull_observer_ptr( observer_ptr<W> p ) nsop_deref_noexcept
+    : ptr( p.get() )
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+    }
+
+    explicit nonnull_observer_ptr( reference r ) nsop_noexcept
+    : ptr( std::addressof( r ) ) {}
+
+    template< class W2
+        nsop_REQUIRES_T(( std::is_convertible<W2*, W*>::value ))
+    >
+    nonnull_observer_ptr( nonnull_observer_ptr<W2> other ) nsop_noexcept
+    : ptr( other.get() ) {}
+
+    nsop_ATTRIBUTE_RETURNS_NONNULL
+    pointer get() const nsop_noexcept
+    {
+        nsop_ASSUME( ptr != nsop_NULLPTR );
+        return ptr;
+    }
+
+    reference operator*() const nsop_noexcept
+    {
+        return *get();
+    }
+
+    pointer operator->() const nsop_noexcept
+    {
+        return get();
+    }
+
+    explicit operator pointer() const nsop_noexcept
+    {
+        return get();
+    }
+
+    operator observer_ptr<W>() const nsop_noexcept
+    {
+        return observer_ptr<W>( get() );
+    }
+
+    void reset( pointer p ) nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( p != nsop_NULLPTR );
+        ptr = p;
+    }
+
+    void swap( nonnull_observer_ptr & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( ptr, other.ptr );
+    }
+
+private:
+    pointer ptr;
+};
+
+// specialized algorithms:
+
+template< class W >
+void swap( nonnull_observer_ptr<W> & p1, nonnull_observer_ptr<W> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class W >
+nonnull_observer_ptr<W> make_nonnull_observer( W * p ) nsop_deref_noexcept
+{
+    return nonnull_observer_ptr<W>( p );
+}
+
+template< class W >
+nonnull_observer_ptr<W> make_nonnull_observer( observer_ptr<W> p ) nsop_deref_noexcept
+{
+    return nonnull_observer_ptr<W>( p );
+}
+
+template< class W >
+nonnull_observer_ptr<W> make_nonnull_observer( W & r ) nsop_noexcept
+{
+    return nonnull_observer_ptr<W>( r );
+}
+
+template< class W1, class W2 >
+bool operator==( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class W1, class W2 >
+bool operator!=( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class W1, class W2 >
+bool operator<( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return std::less< typename detail::common_type<W1*,W2*>::type >()( p1.get(), p2.get() );
+}
+
+template< class W1, class W2 >
+bool operator>( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class W1, class W2 >
+bool operator<=( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class W1, class W2 >
+bool operator>=( nonnull_observer_ptr<W1> p1, nonnull_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+// restrict_observer_ptr: observer that promises, as a T * nsop_RESTRICT, that while it is in
+// scope the memory modified through it is accessed through it only. The pointer member is
+// restrict-qualified, so that for a kernel that takes restrict observers of several buffers
+// by value the compiler knows the buffers do not overlap and vectorizes loops without a
+// run-time overlap check. Passed by reference, the promise is lost. A qualifier on a returned
+// pointer is ignored, hence get() yields a plain pointer and restrict_pointer serves to keep
+// the promise in a local variable. Observing overlapping memory that is modified is undefined
+// behaviour, as for restrict pointers.
+
+template< class W >
+class restrict_observer_ptr
+{
+public:
+    typedef W   element_type;
+    typedef W * pointer;
+    typedef W * nsop_RESTRICT restrict_pointer;
+    typedef W & reference;
+
+    nsop_constexpr restrict_observer_ptr() nsop_noexcept
+    : ptr( nsop_NULLPTR ) {}
+
+    nsop_constexpr restrict_observer_ptr( std::nullptr_t ) nsop_noexcept
+    : ptr( nsop_NULLPTR ) {}
+
+    explicit restrict_observer_ptr( pointer p ) nsop_noexcept
+    : ptr( p ) {}
+
+    explicit restrict_observer_ptr( observer_ptr<W> p ) nsop_noexcept
+    : ptr( p.get() ) {}
+
+    template< class W2
+        nsop_REQUIRES_T(( std::is_convertible<W2*, W*>::value ))
+    >
+    restrict_observer_ptr( restrict_observer_ptr<W2> other ) nsop_noexcept
+    : ptr( other.get() ) {}
+
+    pointer get() const nsop_noexcept
+    {
+        return ptr;
+    }
+
+    reference operator*() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return *ptr;
+    }
+
+    pointer operator->() const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return ptr;
+    }
+
+    // Element i of the observed array:
+
+    reference operator[]( std::ptrdiff_t i ) const nsop_deref_noexcept
+    {
+        nsop_DEREF_CHECK( ptr != nsop_NULLPTR );
+        return ptr[ i ];
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return ptr != nsop_NULLPTR;
+    }
+
+    explicit operator pointer() const nsop_noexcept
+    {
+        return ptr;
+    }
+
+    operator observer_ptr<W>() const nsop_noexcept
+    {
+        return observer_ptr<W>( ptr );
+    }
+
+    pointer release() nsop_noexcept
+    {
+        pointer p( ptr );
+        reset();
+        return p;
+    }
+
+    void reset( pointer p = nsop_NULLPTR ) nsop_noexcept
+    {
+        ptr = p;
+    }
+
+    void swap( restrict_observer_ptr & other ) nsop_noexcept
+    {
+        pointer p( ptr );
+        ptr = other.ptr;
+        other.ptr = p;
+    }
+
+private:
+    restrict_pointer ptr;
+};
+
+// specialized algorithms:
+
+template< class W >
+void swap( restrict_observer_ptr<W> & p1, restrict_observer_ptr<W> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class W >
+restrict_observer_ptr<W> make_restrict_observer( W * p ) nsop_noexcept
+{
+    return restrict_observer_ptr<W>( p );
+}
+
+template< class W >
+restrict_observer_ptr<W> make_restrict_observer( observer_ptr<W> p ) nsop_noexcept
+{
+    return restrict_observer_ptr<W>( p );
+}
+
+template< class W1, class W2 >
+bool operator==( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class W1, class W2 >
+bool operator!=( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class W >
+bool operator==( restrict_observer_ptr<W> p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W >
+bool operator==( std::nullptr_t, restrict_observer_ptr<W> p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class W >
+bool operator!=( restrict_observer_ptr<W> p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W >
+bool operator!=( std::nullptr_t, restrict_observer_ptr<W> p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class W1, class W2 >
+bool operator<( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return std::less< typename detail::common_type<W1*,W2*>::type >()( p1.get(), p2.get() );
+}
+
+template< class W1, class W2 >
+bool operator>( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class W1, class W2 >
+bool operator<=( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class W1, class W2 >
+bool operator>=( restrict_observer_ptr<W1> p1, restrict_observer_ptr<W2> p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+// observer_hash: hash of the observed address that spreads over all bits, also for objects
+// with a large alignment, for hash tables of 2^n buckets. It accepts pointers and observers,
+// i.e. any type with get(). std::hash of the nonstd observers uses it if nsop_CONFIG_MIXING_HASH
+// is 1; T must then be complete where such an observer is hashed.
+
+struct observer_hash
+{
+    template< class T >
+    std::size_t operator()( T * p ) const nsop_noexcept
+    {
+        return detail::mix_address( p );
+    }
+
+    template< class P >
+    auto operator()( P const & p ) const nsop_noexcept -> decltype( detail::mix_address( p.get() ) )
+    {
+        return detail::mix_address( p.get() );
+    }
+};
+
+namespace detail
+{
+    // The pointer a pointer, an observer or a smart pointer refers to, i.e. any type with
+    // get(); used by the extensions to access observers uniformly:
+
+    template< class T >
+    inline T * observed_address( T * p ) nsop_noexcept
+    {
+        return p;
+    }
+
+    template< class P >
+    inline auto observed_address( P const & p ) nsop_noexcept -> decltype( p.get() )
+    {
+        return p.get();
+    }
+
+    // The same as an integer, to compare, sort and hash addresses:
+
+    template< class P >
+    inline std::uintptr_t address_of( P const & p ) nsop_noexcept
+    {
+        return reinterpret_cast<std::uintptr_t>( observed_address( p ) );
+    }
+
+    // The address a lookup key refers to; smart pointers per nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_*:
+
+    template< class T >
+    inline T * key_address( T * p ) nsop_noexcept
+    {
+        return p;
+    }
+
+    template< class T >
+    inline T * key_address( observer_ptr<T> const & p ) nsop_noexcept
+    {
+        return observed_address( p );
+    }
+
+    template< class T >
+    inline T * key_address( nonnull_observer_ptr<T> const & p ) nsop_noexcept
+    {
+        return observed_address( p );
+    }
+
+#if nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_UNIQUE_PTR && nsop_HAVE_STD_SMART_PTRS
+    template< class T >
+    inline T * key_address( std::unique_ptr<T> const & p ) nsop_noexcept
+    {
+        return observed_address( p );
+    }
+#endif
+
+#if nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_SHARED_PTR && nsop_HAVE_STD_SMART_PTRS
+    template< class T >
+    inline T * key_address( std::shared_ptr<T> const & p ) nsop_noexcept
+    {
+        return observed_address( p );
+    }
+#endif
+} // namespace detail
+
+// Transparent functors for heterogeneous lookup in containers of observers, e.g. find() with
+// a T* in a std::set< observer_ptr<T>, observer_less >. The arguments may be a T*, an
+// observer_ptr<T>, a nonnull_observer_ptr<T> and, if the nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_*
+// option allows, a std::unique_ptr<T> or std::shared_ptr<T>.
+
+// observer_equal: whether two keys refer to the same address:
+
+struct observer_equal
+{
+    typedef void is_transparent;
+
+    template< class P1, class P2 >
+    auto operator()( P1 const & a, P2 const & b ) const nsop_noexcept
+        -> decltype( detail::key_address( a ) == detail::key_address( b ) )
+    {
+        return detail::key_address( a ) == detail::key_address( b );
+    }
+};
+
+// observer_less: order of the addresses, as operator< orders observers; keys of related
+// types compare as their composite pointer type:
+
+struct observer_less
+{
+    typedef void is_transparent;
+
+    template< class P1, class P2 >
+    auto operator()( P1 const & a, P2 const & b ) const nsop_noexcept
+        -> decltype( detail::key_address( a ) < detail::key_address( b ) )
+    {
+        typedef typename detail::common_type< decltype( detail::key_address( a ) ), decltype( detail::key_address( b ) ) >::type pointer;
+
+        return std::less< pointer >()( detail::key_address( a ), detail::key_address( b ) );
+    }
+};
+
+// observer_key_hash: hash of a key as an observer_ptr<T>, via Hash; converting a pointer to
+// a derived class to T* first, so that equal keys hash alike:
+
+template< class T, class Hash = std::hash< observer_ptr<T> > >
+struct observer_key_hash
+{
+    typedef void is_transparent;
+
+    template< class P >
+    auto operator()( P const & p ) const
+        -> decltype( std::declval<Hash const &>()( observer_ptr<T>( detail::key_address( p ) ) ) )
+    {
+        return hash( observer_ptr<T>( detail::key_address( p ) ) );
+    }
+
+    Hash hash;
+};
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::observer_hash;
+using observer_ptr_lite::observer_equal;
+using observer_ptr_lite::observer_less;
+using observer_ptr_lite::observer_key_hash;
+using observer_ptr_lite::tagged_observer_ptr;
+using observer_ptr_lite::make_tagged_observer;
+using observer_ptr_lite::observer_ptr32;
+using observer_ptr_lite::make_observer32;
+using observer_ptr_lite::offset_observer_ptr;
+using observer_ptr_lite::nonnull_observer_ptr;
+using observer_ptr_lite::make_nonnull_observer;
+using observer_ptr_lite::restrict_observer_ptr;
+using observer_ptr_lite::make_restrict_observer;
+
+} // namespace nonstd
+
+namespace std
+{
+
+template< class T, unsigned Bits >
+struct hash< ::nonstd::tagged_observer_ptr<T, Bits> >
+{
+    size_t operator()( ::nonstd::tagged_observer_ptr<T, Bits> p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+template< class T, class Arena >
+struct hash< ::nonstd::observer_ptr32<T, Arena> >
+{
+    size_t operator()( ::nonstd::observer_ptr32<T, Arena> p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+template< class T >
+struct hash< ::nonstd::offset_observer_ptr<T> >
+{
+    size_t operator()( ::nonstd::offset_observer_ptr<T> const & p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+template< class T >
+struct hash< ::nonstd::nonnull_observer_ptr<T> >
+{
+    size_t operator()( ::nonstd::nonnull_observer_ptr<T> p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+template< class T >
+struct hash< ::nonstd::restrict_observer_ptr<T> >
+{
+    size_t operator()( ::nonstd::restrict_observer_ptr<T> p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+}
+#endif // nsop_CPP11_OR_GREATER
+
+// #undef ...
+
 #endif // NONSTD_OBSERVER_PTR_H_INCLUDED
 
 // end of file
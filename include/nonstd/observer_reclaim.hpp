@@ -0,0 +1,265 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// Per-thread records and retired objects of the reclamation domains of nonstd::hazard_domain and nonstd::epoch_domain, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_RECLAIM_H_INCLUDED
+#define NONSTD_OBSERVER_RECLAIM_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+
+// Size of a cache line, for padding of data that different threads write:
+
+#ifndef  nsop_CONFIG_CACHE_LINE_SIZE
+# define nsop_CONFIG_CACHE_LINE_SIZE  64
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // Create and destroy an object aligned to the cache line, as ::operator new
+    // only guarantees the alignment of over-aligned types as of C++17:
+
+    template< class T >
+    T * new_aligned()
+    {
+        std::size_t const align = alignof( T );
+        void * const raw = ::operator new( sizeof( T ) + sizeof( void * ) + align - 1 );
+        std::uintptr_t const addr = ( reinterpret_cast<std::uintptr_t>( raw ) + sizeof( void * ) + align - 1 ) & ~( align - 1 );
+        void ** const place = reinterpret_cast<void **>( addr );
+        place[-1] = raw;
+        return new( place ) T();
+    }
+
+    template< class T >
+    void delete_aligned( T * p ) nsop_noexcept
+    {
+        void * const raw = reinterpret_cast<void **>( p )[-1];
+        p->~T();
+        ::operator delete( raw );
+    }
+
+    // Per-thread records of a reclamation domain (hazard pointers, epochs).
+    // A thread owns a record while it uses the domain; records of exited threads are reused.
+    // The domain and the owning thread agree via the record's state who deletes it.
+
+    template< class Derived >
+    struct thread_record
+    {
+        enum state_type { free_state, owned_state, orphaned_state };
+
+        std::atomic<int> state;
+        Derived *        next;
+
+        thread_record() nsop_noexcept
+        : state( owned_state ), next( nsop_NULLPTR ) {}
+    };
+
+    // Give up ownership of a record; the last of domain and thread deletes it:
+
+    template< class Record >
+    void release_record( Record * rec ) nsop_noexcept
+    {
+        if ( rec->state.exchange( Record::free_state, std::memory_order_acq_rel ) == Record::orphaned_state )
+        {
+            delete_aligned( rec );
+        }
+    }
+
+    // The records a thread owns, per domain:
+
+    template< class Record, std::size_t N >
+    struct thread_record_cache
+    {
+        struct entry
+        {
+            std::uint64_t domain;
+            Record *      record;
+        };
+
+        entry       entries[ N ];
+        std::size_t size;
+
+        thread_record_cache() nsop_noexcept
+        : size( 0 ) {}
+
+        ~thread_record_cache()
+        {
+            for ( std::size_t i = 0; i != size; ++i )
+            {
+                release_record( entries[i].record );
+            }
+        }
+
+        Record * find( std::uint64_t domain ) const nsop_noexcept
+        {
+            for ( std::size_t i = 0; i != size; ++i )
+            {
+                if ( entries[i].domain == domain )
+                    return entries[i].record;
+            }
+            return nsop_NULLPTR;
+        }
+
+        bool insert( std::uint64_t domain, Record * rec ) nsop_noexcept
+        {
+            // Make room by dropping records of destroyed domains:
+
+            for ( std::size_t i = 0; i != size; )
+            {
+                if ( entries[i].record->state.load( std::memory_order_acquire ) == Record::orphaned_state )
+                {
+                    delete_aligned( entries[i].record );
+                    entries[i] = entries[ --size ];
+                }
+                else
+                {
+                    ++i;
+                }
+            }
+
+            if ( size == N )
+                return false;
+
+            entries[ size++ ] = entry{ domain, rec };
+            return true;
+        }
+    };
+
+    inline std::uint64_t new_domain_id() nsop_noexcept
+    {
+        static std::atomic<std::uint64_t> next( 1 );
+        return next.fetch_add( 1, std::memory_order_relaxed );
+    }
+
+    // record_list: the lock-free list of the records of a domain. Records are only
+    // removed when the list is destroyed; records that a thread owns are orphaned then.
+    // The domain must not be in use when it is destroyed.
+
+    template< class Record, std::size_t N >
+    class record_list
+    {
+    public:
+        record_list() nsop_noexcept
+        : head( nsop_NULLPTR ), count( 0 ), id( new_domain_id() ) {}
+
+        record_list( record_list const & ) = delete;
+        record_list & operator=( record_list const & ) = delete;
+
+        ~record_list()
+        {
+            for ( Record * rec = first(); rec; )
+            {
+                Record * const next = rec->next;
+
+                if ( rec->state.exchange( Record::orphaned_state, std::memory_order_acq_rel ) != Record::owned_state )
+                {
+                    delete_aligned( rec );
+                }
+                rec = next;
+            }
+        }
+
+        Record * first() const nsop_noexcept
+        {
+            return head.load( std::memory_order_acquire );
+        }
+
+        std::size_t size() const nsop_noexcept
+        {
+            return count.load( std::memory_order_relaxed );
+        }
+
+        // The record of this thread; a temporary record if the thread's cache is full:
+
+        Record * thread_record( bool & temporary )
+        {
+            static thread_local thread_record_cache<Record, N> cache;
+
+            if ( Record * const rec = cache.find( id ) )
+            {
+                temporary = false;
+                return rec;
+            }
+
+            Record * const rec = acquire();
+            temporary = !cache.insert( id, rec );
+            return rec;
+        }
+
+        // A free record, or a new one:
+
+        Record * acquire()
+        {
+            for ( Record * rec = first(); rec; rec = rec->next )
+            {
+                int expected = Record::free_state;
+
+                if ( rec->state.load( std::memory_order_relaxed ) == expected &&
+                     rec->state.compare_exchange_strong( expected, Record::owned_state, std::memory_order_acquire, std::memory_order_relaxed ) )
+                {
+                    return rec;
+                }
+            }
+
+            Record * const rec = new_aligned<Record>();
+
+            rec->next = head.load( std::memory_order_relaxed );
+            while ( !head.compare_exchange_weak( rec->next, rec, std::memory_order_release, std::memory_order_relaxed ) ) {}
+
+            count.fetch_add( 1, std::memory_order_relaxed );
+            return rec;
+        }
+
+    private:
+        std::atomic<Record *>    head;
+        std::atomic<std::size_t> count;
+        std::uint64_t const      id;
+    };
+
+    // An object to reclaim, and how:
+
+    struct retired_object
+    {
+        void * object;
+        void (*reclaim)( void * );
+    };
+
+    template< class T, class D >
+    void reclaim_retired( void * p )
+    {
+        D()( static_cast<T *>( p ) );
+    }
+
+    template< class T, class D >
+    retired_object make_retired( T * p ) nsop_noexcept
+    {
+        static_assert( std::is_empty<D>::value && std::is_default_constructible<D>::value,
+            "retire(): requires a stateless deleter" );
+
+        return retired_object{ const_cast<void *>( static_cast<void const *>( p ) ), &reclaim_retired<T, D> };
+    }
+} // namespace detail
+
+} // namespace observer_ptr_lite
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_RECLAIM_H_INCLUDED
+
+// end of file
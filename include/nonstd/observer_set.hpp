@@ -0,0 +1,688 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_set<> and nonstd::observer_map<>: flat open-addressing hash containers keyed by observers, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_SET_H_INCLUDED
+#define NONSTD_OBSERVER_SET_H_INCLUDED
+
+#include "observer_bulk.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+// The table probes per nsop_CONFIG_SIMD, so it and the containers are in the inline
+// namespace of the instruction set, see observer_bulk.hpp:
+
+namespace detail { inline namespace nsop_SIMD_NAMESPACE {
+
+    // Mapped values in the slots of a table, none for a set:
+
+    template< class V >
+    class mapped_slots
+    {
+    public:
+        void resize( std::size_t n ) { values.resize( n ); }
+        void clear( std::size_t i ) { values[i] = V(); }
+        void move( std::size_t from, std::size_t to ) { values[to] = std::move( values[from] ); }
+        void move( mapped_slots & other, std::size_t from, std::size_t to ) { values[to] = std::move( other.values[from] ); }
+        void swap( mapped_slots & other ) nsop_noexcept { values.swap( other.values ); }
+
+        V       & operator[]( std::size_t i )       { return values[i]; }
+        V const & operator[]( std::size_t i ) const { return values[i]; }
+
+    private:
+        std::vector<V> values;
+    };
+
+    template<>
+    class mapped_slots<void>
+    {
+    public:
+        void resize( std::size_t ) {}
+        void clear( std::size_t ) {}
+        void move( std::size_t, std::size_t ) {}
+        void move( mapped_slots &, std::size_t, std::size_t ) {}
+        void swap( mapped_slots & ) nsop_noexcept {}
+    };
+
+    // flat_table: open addressing with linear probing; the keys are observers, stored densely,
+    // a null observer marks an empty slot. A probe compares a vector of keys at once, per
+    // nsop_CONFIG_SIMD. The probe sequences do not wrap around: the home slot of a key is
+    // in [0, capacity), the slots after it are overflow; the last ones always stay empty, so
+    // that a probe stops before the end. The table doubles only when the load exceeds 3/4; a
+    // run that reaches the end extends the overflow, so that a poor hash makes lookups slower
+    // without growing the table. Erasing shifts the following keys of the run back, so that
+    // no tombstones are needed.
+
+    template< class T, class V, class Hash >
+    class flat_table
+    {
+    public:
+        static std::size_t const npos = static_cast<std::size_t>( -1 );
+
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+        static std::size_t const probe_width = lanes;
+#else
+        static std::size_t const probe_width = 1;
+#endif
+        static std::size_t const overflow_slots   = 32;
+        static std::size_t const minimum_capacity = 16;
+
+        flat_table() nsop_noexcept
+        : mask( 0 ), count( 0 ) {}
+
+        explicit flat_table( Hash const & h )
+        : hash( h ), mask( 0 ), count( 0 ) {}
+
+        std::size_t size() const nsop_noexcept
+        {
+            return count;
+        }
+
+        std::size_t capacity() const nsop_noexcept
+        {
+            return keys.empty() ? 0 : mask + 1;
+        }
+
+        std::size_t slot_count() const nsop_noexcept
+        {
+            return keys.size();
+        }
+
+        // Index of the slot of key, npos if absent:
+
+        std::size_t find( observer_ptr<T> key ) const nsop_noexcept
+        {
+            if ( keys.empty() || !key )
+                return npos;
+
+            std::size_t i = home( key );
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+            vec const value = splat( address_of( key ) );
+            vec const null  = splat( 0 );
+
+            for ( ;; i += lanes )
+            {
+                vec const v = load( keys.data() + i );
+                unsigned const m = equal( v, value );
+
+                if ( m != 0 )
+                    return i + lowest_bit( m );
+
+                if ( equal( v, null ) != 0 )
+                    return npos;
+            }
+#else
+            for ( ;; ++i )
+            {
+                if ( keys[i] == key )
+                    return i;
+
+                if ( !keys[i] )
+                    return npos;
+            }
+#endif
+        }
+
+        // Index of the slot of key and whether it was inserted; V is default-constructed:
+
+        std::pair< std::size_t, bool > insert( observer_ptr<T> key )
+        {
+            assert( key && "observer_set, observer_map: key must not be null" );
+
+            std::size_t const i = find( key );
+
+            if ( i != npos )
+                return std::make_pair( i, false );
+
+            if ( 4 * ( count + 1 ) > 3 * capacity() )
+                rehash( capacity() == 0 ? minimum_capacity : 2 * capacity() );
+
+            std::size_t const j = place( key );
+
+            values.resize( keys.size() );
+            ++count;
+            return std::make_pair( j, true );
+        }
+
+        // Erase the key in slot i, shift the following keys of the run back into the gap:
+
+        void erase( std::size_t i )
+        {
+            for ( std::size_t j = i + 1; keys[j]; ++j )
+            {
+                if ( home( keys[j] ) <= i )
+                {
+                    keys[i] = keys[j];
+                    values.move( j, i );
+                    i = j;
+                }
+            }
+            keys[i] = observer_ptr<T>();
+            values.clear( i );
+            --count;
+        }
+
+        void clear()
+        {
+            flat_table empty( hash );
+            swap( empty );
+        }
+
+        // Grow to at least n keys without rehashing:
+
+        void reserve( std::size_t n )
+        {
+            std::size_t cap = minimum_capacity;
+
+            while ( 4 * n > 3 * cap )
+                cap *= 2;
+
+            if ( cap > capacity() )
+                rehash( cap );
+        }
+
+        void swap( flat_table & other ) nsop_noexcept
+        {
+            using std::swap;
+            swap( hash, other.hash );
+            swap( mask, other.mask );
+            swap( count, other.count );
+            keys.swap( other.keys );
+            values.swap( other.values );
+        }
+
+        Hash hash;
+        std::vector< observer_ptr<T> > keys;
+        mapped_slots<V> values;
+
+    private:
+        std::size_t home( observer_ptr<T> key ) const nsop_noexcept
+        {
+            return hash( key ) & mask;
+        }
+
+        // Index of the first empty slot from slot i on:
+
+        std::size_t first_empty( std::size_t i ) const nsop_noexcept
+        {
+#if nsop_CONFIG_SIMD != nsop_SIMD_NONE
+            vec const null = splat( 0 );
+
+            for ( ;; i += lanes )
+            {
+                unsigned const m = equal( load( keys.data() + i ), null );
+
+                if ( m != 0 )
+                    return i + lowest_bit( m );
+            }
+#else
+            for ( ; keys[i]; ++i ) {}
+
+            return i;
+#endif
+        }
+
+        // Put key in the first empty slot of its run, extending the overflow if the slot is
+        // one of the last probe_width, that must stay empty; the values are not resized:
+
+        std::size_t place( observer_ptr<T> key )
+        {
+            std::size_t const j = first_empty( home( key ) );
+
+            if ( j >= keys.size() - probe_width )
+                keys.resize( j + probe_width + overflow_slots );
+
+            keys[j] = key;
+            return j;
+        }
+
+        // Place the keys in a table of cap home slots, then move the values:
+
+        void rehash( std::size_t cap )
+        {
+            flat_table next( hash );
+            std::vector< std::size_t > where( keys.size() );
+
+            next.keys.assign( cap + overflow_slots, observer_ptr<T>() );
+            next.mask = cap - 1;
+
+            for ( std::size_t i = 0; i != keys.size(); ++i )
+            {
+                if ( keys[i] )
+                    where[i] = next.place( keys[i] );
+            }
+
+            next.values.resize( next.keys.size() );
+
+            for ( std::size_t i = 0; i != keys.size(); ++i )
+            {
+                if ( keys[i] )
+                    next.values.move( values, i, where[i] );
+            }
+
+            next.count = count;
+            swap( next );
+        }
+
+        std::size_t mask;
+        std::size_t count;
+    };
+
+    // slot_iterator: iterator over the occupied slots of a table; yields what
+    // Container::slot( table, i ) returns, e.g. a pair of the key and a value reference. As
+    // that may be a proxy returned by value, it is an input iterator and operator-> returns
+    // an arrow_proxy that holds it:
+
+    template< class Reference >
+    struct arrow_proxy
+    {
+        typename std::remove_reference<Reference>::type const * operator->() const nsop_noexcept
+        {
+            return &value;
+        }
+
+        Reference value;
+    };
+
+    template< class Container, class Table, class Reference >
+    class slot_iterator
+    {
+    public:
+        typedef std::input_iterator_tag iterator_category;
+        typedef typename std::decay<Reference>::type value_type;
+        typedef Reference                 reference;
+        typedef arrow_proxy<Reference>    pointer;
+        typedef std::ptrdiff_t            difference_type;
+
+        slot_iterator( Table * t, std::size_t i ) nsop_noexcept
+        : table( t ), index( i )
+        {
+            skip();
+        }
+
+        reference operator*() const
+        {
+            return Container::slot( *table, index );
+        }
+
+        pointer operator->() const
+        {
+            return pointer{ **this };
+        }
+
+        slot_iterator & operator++() nsop_noexcept
+        {
+            ++index;
+            skip();
+            return *this;
+        }
+
+        slot_iterator operator++( int ) nsop_noexcept
+        {
+            slot_iterator result( *this );
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==( slot_iterator const & a, slot_iterator const & b ) nsop_noexcept
+        {
+            return a.index == b.index;
+        }
+
+        friend bool operator!=( slot_iterator const & a, slot_iterator const & b ) nsop_noexcept
+        {
+            return a.index != b.index;
+        }
+
+    private:
+        void skip() nsop_noexcept
+        {
+            while ( index != table->slot_count() && !table->keys[ index ] )
+                ++index;
+        }
+
+        Table * table;
+        std::size_t index;
+    };
+} // namespace nsop_SIMD_NAMESPACE
+} // namespace detail
+
+inline namespace nsop_SIMD_NAMESPACE {
+
+// observer_set: set of non-null observers in a flat open-addressing table. The null observer
+// marks an empty slot, so a slot is just the observer. Inserting may rehash and invalidates
+// iterators, erasing invalidates iterators. Hash defaults to observer_hash, that spreads the
+// addresses of aligned objects over the slots.
+
+template< class T, class Hash = observer_hash >
+class observer_set
+{
+    typedef detail::flat_table< T, void, Hash > table_type;
+
+public:
+    typedef observer_ptr<T> key_type;
+    typedef observer_ptr<T> value_type;
+    typedef std::size_t     size_type;
+    typedef Hash            hasher;
+
+    typedef detail::slot_iterator< observer_set, table_type const, observer_ptr<T> const & > iterator;
+    typedef iterator const_iterator;
+
+    observer_set() {}
+
+    explicit observer_set( size_type n, Hash const & h = Hash() )
+    : table( h )
+    {
+        table.reserve( n );
+    }
+
+    observer_set( std::initializer_list< observer_ptr<T> > keys )
+    {
+        insert( keys.begin(), keys.end() );
+    }
+
+    template< class It >
+    observer_set( It first, It last )
+    {
+        insert( first, last );
+    }
+
+    size_type size() const nsop_noexcept
+    {
+        return table.size();
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return table.size() == 0;
+    }
+
+    size_type capacity() const nsop_noexcept
+    {
+        return table.capacity();
+    }
+
+    std::pair< iterator, bool > insert( observer_ptr<T> key )
+    {
+        std::pair< std::size_t, bool > const r = table.insert( key );
+        return std::make_pair( iterator( &table, r.first ), r.second );
+    }
+
+    template< class It >
+    void insert( It first, It last )
+    {
+        for ( ; first != last; ++first )
+            insert( *first );
+    }
+
+    size_type erase( observer_ptr<T> key )
+    {
+        std::size_t const i = table.find( key );
+
+        if ( i == table_type::npos )
+            return 0;
+
+        table.erase( i );
+        return 1;
+    }
+
+    bool contains( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return table.find( key ) != table_type::npos;
+    }
+
+    size_type count( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return contains( key ) ? 1 : 0;
+    }
+
+    void clear()
+    {
+        table.clear();
+    }
+
+    void reserve( size_type n )
+    {
+        table.reserve( n );
+    }
+
+    void swap( observer_set & other ) nsop_noexcept
+    {
+        table.swap( other.table );
+    }
+
+    iterator begin() const nsop_noexcept
+    {
+        return iterator( &table, 0 );
+    }
+
+    iterator end() const nsop_noexcept
+    {
+        return iterator( &table, table.slot_count() );
+    }
+
+    hasher hash_function() const
+    {
+        return table.hash;
+    }
+
+private:
+    template< class, class, class > friend class detail::slot_iterator;
+
+    static observer_ptr<T> const & slot( table_type const & t, std::size_t i ) nsop_noexcept
+    {
+        return t.keys[i];
+    }
+
+    table_type table;
+};
+
+// observer_map: map from non-null observers to values of V in a flat open-addressing table.
+// The observers are stored densely, the values in a parallel array; V must be default
+// constructible. An empty slot holds a null observer and V(). find() yields an observer of
+// the value; iterators yield a pair of the key and a reference to the value. Inserting may
+// rehash and invalidates iterators and observers of values, erasing invalidates iterators.
+
+template< class T, class V, class Hash = observer_hash >
+class observer_map
+{
+    typedef detail::flat_table< T, V, Hash > table_type;
+
+public:
+    typedef observer_ptr<T> key_type;
+    typedef V               mapped_type;
+    typedef std::size_t     size_type;
+    typedef Hash            hasher;
+
+    typedef detail::slot_iterator< observer_map, table_type      , std::pair< observer_ptr<T>, V       & > > iterator;
+    typedef detail::slot_iterator< observer_map, table_type const, std::pair< observer_ptr<T>, V const & > > const_iterator;
+
+    observer_map() {}
+
+    explicit observer_map( size_type n, Hash const & h = Hash() )
+    : table( h )
+    {
+        table.reserve( n );
+    }
+
+    size_type size() const nsop_noexcept
+    {
+        return table.size();
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return table.size() == 0;
+    }
+
+    size_type capacity() const nsop_noexcept
+    {
+        return table.capacity();
+    }
+
+    // Insert key with value, unless key is present:
+
+    std::pair< iterator, bool > insert( observer_ptr<T> key, V value )
+    {
+        std::pair< std::size_t, bool > const r = table.insert( key );
+
+        if ( r.second )
+            table.values[ r.first ] = std::move( value );
+
+        return std::make_pair( iterator( &table, r.first ), r.second );
+    }
+
+    // Insert key with value, or assign value if key is present:
+
+    std::pair< iterator, bool > insert_or_assign( observer_ptr<T> key, V value )
+    {
+        std::pair< std::size_t, bool > const r = table.insert( key );
+
+        table.values[ r.first ] = std::move( value );
+
+        return std::make_pair( iterator( &table, r.first ), r.second );
+    }
+
+    // The value of key, inserted as V() if key is absent:
+
+    V & operator[]( observer_ptr<T> key )
+    {
+        return table.values[ table.insert( key ).first ];
+    }
+
+    size_type erase( observer_ptr<T> key )
+    {
+        std::size_t const i = table.find( key );
+
+        if ( i == table_type::npos )
+            return 0;
+
+        table.erase( i );
+        return 1;
+    }
+
+    // Observer of the value of key, null if key is absent:
+
+    observer_ptr<V> find( observer_ptr<T> key ) nsop_noexcept
+    {
+        std::size_t const i = table.find( key );
+        return i != table_type::npos ? observer_ptr<V>( &table.values[i] ) : observer_ptr<V>();
+    }
+
+    observer_ptr<V const> find( observer_ptr<T> key ) const nsop_noexcept
+    {
+        std::size_t const i = table.find( key );
+        return i != table_type::npos ? observer_ptr<V const>( &table.values[i] ) : observer_ptr<V const>();
+    }
+
+    bool contains( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return table.find( key ) != table_type::npos;
+    }
+
+    size_type count( observer_ptr<T> key ) const nsop_noexcept
+    {
+        return contains( key ) ? 1 : 0;
+    }
+
+    void clear()
+    {
+        table.clear();
+    }
+
+    void reserve( size_type n )
+    {
+        table.reserve( n );
+    }
+
+    void swap( observer_map & other ) nsop_noexcept
+    {
+        table.swap( other.table );
+    }
+
+    iterator begin() nsop_noexcept
+    {
+        return iterator( &table, 0 );
+    }
+
+    iterator end() nsop_noexcept
+    {
+        return iterator( &table, table.slot_count() );
+    }
+
+    const_iterator begin() const nsop_noexcept
+    {
+        return const_iterator( &table, 0 );
+    }
+
+    const_iterator end() const nsop_noexcept
+    {
+        return const_iterator( &table, table.slot_count() );
+    }
+
+    hasher hash_function() const
+    {
+        return table.hash;
+    }
+
+private:
+    template< class, class, class > friend class detail::slot_iterator;
+
+    static std::pair< observer_ptr<T>, V & > slot( table_type & t, std::size_t i ) nsop_noexcept
+    {
+        return std::pair< observer_ptr<T>, V & >( t.keys[i], t.values[i] );
+    }
+
+    static std::pair< observer_ptr<T>, V const & > slot( table_type const & t, std::size_t i ) nsop_noexcept
+    {
+        return std::pair< observer_ptr<T>, V const & >( t.keys[i], t.values[i] );
+    }
+
+    table_type table;
+};
+
+// specialized algorithms:
+
+template< class T, class Hash >
+void swap( observer_set<T, Hash> & a, observer_set<T, Hash> & b ) nsop_noexcept
+{
+    a.swap( b );
+}
+
+template< class T, class V, class Hash >
+void swap( observer_map<T, V, Hash> & a, observer_map<T, V, Hash> & b ) nsop_noexcept
+{
+    a.swap( b );
+}
+
+} // namespace nsop_SIMD_NAMESPACE
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::observer_set;
+using observer_ptr_lite::observer_map;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_SET_H_INCLUDED
+
+// end of file
@@ -0,0 +1,310 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::slot_map<> and nonstd::checked_observer<>: generational slot map with validated observer handles, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_SLOT_MAP_H_INCLUDED
+#define NONSTD_OBSERVER_SLOT_MAP_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+template< class T > class slot_map;
+
+// checked_observer: a handle to an element of a slot_map<T>, the index of its slot and the
+// generation of the slot when the element was inserted. It resolves to a null observer once
+// the element is erased, also when the slot has been reused. Eight bytes.
+
+template< class T >
+class checked_observer
+{
+public:
+    typedef T             element_type;
+    typedef std::uint32_t index_type;
+    typedef std::uint32_t generation_type;
+
+    // A default-constructed handle never resolves:
+
+    nsop_constexpr checked_observer() nsop_noexcept
+    : idx( 0 ), gen( 0 ) {}
+
+    nsop_constexpr checked_observer( index_type i, generation_type g ) nsop_noexcept
+    : idx( i ), gen( g ) {}
+
+    nsop_constexpr index_type index() const nsop_noexcept
+    {
+        return idx;
+    }
+
+    nsop_constexpr generation_type generation() const nsop_noexcept
+    {
+        return gen;
+    }
+
+    observer_ptr<T> resolve( slot_map<T> & map ) const nsop_noexcept
+    {
+        return map.find( *this );
+    }
+
+    observer_ptr<T const> resolve( slot_map<T> const & map ) const nsop_noexcept
+    {
+        return map.find( *this );
+    }
+
+private:
+    index_type      idx;
+    generation_type gen;
+};
+
+template< class T >
+nsop_constexpr bool operator==( checked_observer<T> const & a, checked_observer<T> const & b ) nsop_noexcept
+{
+    return a.index() == b.index() && a.generation() == b.generation();
+}
+
+template< class T >
+nsop_constexpr bool operator!=( checked_observer<T> const & a, checked_observer<T> const & b ) nsop_noexcept
+{
+    return !( a == b );
+}
+
+// slot_map: the elements are stored contiguously; erasing an element moves the last one into
+// its place. The slots map a handle to the position of its element and have a generation
+// that changes when the element is erased. Erased slots are reused via a free list.
+// The generation of a slot in use is odd, that of a free slot even, so that no handle
+// resolves to a free slot. Slot 0 is never used, so that a default-constructed handle
+// never resolves; a handle of slot 0 or of a slot out of range is absent, whatever its
+// generation. Inserting and erasing invalidate observers and iterators, not handles.
+// A generation wraps around after 2^31 reuses of its slot.
+
+template< class T >
+class slot_map
+{
+public:
+    typedef T                   value_type;
+    typedef checked_observer<T> key_type;
+    typedef std::size_t         size_type;
+
+    typedef typename std::vector<T>::iterator       iterator;
+    typedef typename std::vector<T>::const_iterator const_iterator;
+
+    slot_map()
+    : slots( 1, slot{ 0, 0 } ), free_head( 0 ) {}
+
+    // Observer access, a range check, one indexed load and a compare:
+
+    observer_ptr<T> find( key_type k ) nsop_noexcept
+    {
+        slot const * s = live_slot( k );
+        return s ? observer_ptr<T>( &values[ s->index ] ) : observer_ptr<T>();
+    }
+
+    observer_ptr<T const> find( key_type k ) const nsop_noexcept
+    {
+        slot const * s = live_slot( k );
+        return s ? observer_ptr<T const>( &values[ s->index ] ) : observer_ptr<T const>();
+    }
+
+    bool contains( key_type k ) const nsop_noexcept
+    {
+        return live_slot( k ) != nsop_NULLPTR;
+    }
+
+    // Modifiers:
+
+    key_type insert( T const & value )
+    {
+        return emplace( value );
+    }
+
+    key_type insert( T && value )
+    {
+        return emplace( std::move( value ) );
+    }
+
+    // Strong exception guarantee: the bookkeeping vectors grow before the element is
+    // constructed, so that their push_back does not throw.
+
+    template< class... Args >
+    key_type emplace( Args &&... args )
+    {
+        if ( free_head == 0 )
+            grow( slots );
+
+        grow( dense_to_slot );
+
+        values.emplace_back( std::forward<Args>( args )... );
+
+        std::uint32_t index = free_head;
+
+        if ( index != 0 )
+        {
+            free_head = slots[ index ].index;
+            ++slots[ index ].generation;
+        }
+        else
+        {
+            index = static_cast<std::uint32_t>( slots.size() );
+            slots.push_back( slot{ 1, 0 } );
+        }
+
+        slots[ index ].index = static_cast<std::uint32_t>( values.size() - 1 );
+        dense_to_slot.push_back( index );
+
+        return key_type( index, slots[ index ].generation );
+    }
+
+    bool erase( key_type k )
+    {
+        if ( !contains( k ) )
+            return false;
+
+        slot & s = slots[ k.index() ];
+        std::uint32_t const last = static_cast<std::uint32_t>( values.size() - 1 );
+
+        if ( s.index != last )
+        {
+            values[ s.index ] = std::move( values[ last ] );
+            dense_to_slot[ s.index ] = dense_to_slot[ last ];
+            slots[ dense_to_slot[ last ] ].index = s.index;
+        }
+
+        values.pop_back();
+        dense_to_slot.pop_back();
+
+        ++s.generation;
+        s.index      = free_head;
+        free_head    = k.index();
+
+        return true;
+    }
+
+    void clear()
+    {
+        while ( !values.empty() )
+        {
+            erase( key_type( dense_to_slot.back(), slots[ dense_to_slot.back() ].generation ) );
+        }
+    }
+
+    void reserve( size_type n )
+    {
+        values.reserve( n );
+        dense_to_slot.reserve( n );
+        slots.reserve( n + 1 );
+    }
+
+    // Capacity:
+
+    size_type size() const nsop_noexcept
+    {
+        return values.size();
+    }
+
+    bool empty() const nsop_noexcept
+    {
+        return values.empty();
+    }
+
+    size_type capacity() const nsop_noexcept
+    {
+        return values.capacity();
+    }
+
+    // The contiguous elements, in unspecified order:
+
+    iterator       begin()        nsop_noexcept { return values.begin(); }
+    iterator       end()          nsop_noexcept { return values.end(); }
+    const_iterator begin()  const nsop_noexcept { return values.begin(); }
+    const_iterator end()    const nsop_noexcept { return values.end(); }
+    const_iterator cbegin() const nsop_noexcept { return values.cbegin(); }
+    const_iterator cend()   const nsop_noexcept { return values.cend(); }
+
+    T *       data()       nsop_noexcept { return values.data(); }
+    T const * data() const nsop_noexcept { return values.data(); }
+
+    // The handle of the element at a position in the contiguous storage:
+
+    key_type key_of( const_iterator pos ) const nsop_noexcept
+    {
+        std::uint32_t const index = dense_to_slot[ static_cast<size_type>( pos - values.begin() ) ];
+        return key_type( index, slots[ index ].generation );
+    }
+
+private:
+    struct slot
+    {
+        std::uint32_t generation;
+        std::uint32_t index;        // of the element if in use, of the next free slot otherwise
+    };
+
+    // Make room for one more element, with geometric growth:
+
+    template< class U >
+    static void grow( std::vector<U> & v )
+    {
+        if ( v.size() == v.capacity() )
+            v.reserve( 2 * v.capacity() + 1 );
+    }
+
+    // The slot of k if its element is present, else null. Index 0 wraps to the largest
+    // value, so that one compare rejects the unused slot 0 and indices out of range;
+    // an even generation is that of a free slot:
+
+    slot const * live_slot( key_type k ) const nsop_noexcept
+    {
+        if ( size_type( k.index() ) - 1 >= slots.size() - 1 || ( k.generation() & 1u ) == 0 )
+            return nsop_NULLPTR;
+
+        slot const & s = slots[ k.index() ];
+        return s.generation == k.generation() ? &s : nsop_NULLPTR;
+    }
+
+    std::vector<T>             values;
+    std::vector<std::uint32_t> dense_to_slot;
+    std::vector<slot>          slots;
+    std::uint32_t              free_head;
+};
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::checked_observer;
+using observer_ptr_lite::slot_map;
+
+} // namespace nonstd
+
+// specialize the std::hash algorithm:
+
+namespace std
+{
+
+template< class T >
+struct hash< ::nonstd::checked_observer<T> >
+{
+    std::size_t operator()( ::nonstd::checked_observer<T> const & k ) const nsop_noexcept
+    {
+        return hash<std::uint64_t>()( ( std::uint64_t( k.generation() ) << 32 ) | k.index() );
+    }
+};
+
+} // namespace std
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_SLOT_MAP_H_INCLUDED
+
+// end of file
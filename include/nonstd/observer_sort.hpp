@@ -0,0 +1,200 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::sort_by_address() etc.: address-ordered sorting and grouping of observers, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_SORT_H_INCLUDED
+#define NONSTD_OBSERVER_SORT_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Size of a memory page, for group_by_page():
+
+#ifndef  nsop_CONFIG_PAGE_SIZE
+# define nsop_CONFIG_PAGE_SIZE  4096
+#endif
+
+// Number of observers below which sort_by_address() uses std::sort():
+
+#ifndef  nsop_CONFIG_RADIX_SORT_THRESHOLD
+# define nsop_CONFIG_RADIX_SORT_THRESHOLD  256
+#endif
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // LSD radix sort of [first, first + n) on the address bits, a byte per pass. A single
+    // pass over the input counts all bytes; a byte that is the same for all observers, such
+    // as the high bytes of nearby heap addresses and the low bytes of aligned objects, is
+    // skipped.
+
+    template< class T >
+    void radix_sort_address( observer_ptr<T> * first, std::size_t n )
+    {
+        std::size_t const digits = sizeof( std::uintptr_t );
+        std::size_t const radix  = 256;
+
+        std::vector< std::size_t > count( digits * radix, 0 );
+
+        for ( std::size_t i = 0; i != n; ++i )
+        {
+            std::uintptr_t const a = address_of( first[i] );
+
+            for ( std::size_t d = 0; d != digits; ++d )
+            {
+                ++count[ d * radix + ( ( a >> ( 8 * d ) ) & 0xff ) ];
+            }
+        }
+
+        std::vector< observer_ptr<T> > buffer( n );
+
+        observer_ptr<T> * src = first;
+        observer_ptr<T> * dst = buffer.data();
+
+        for ( std::size_t d = 0; d != digits; ++d )
+        {
+            std::size_t * const c = &count[ d * radix ];
+
+            if ( std::find( c, c + radix, n ) != c + radix )
+                continue;
+
+            for ( std::size_t b = 0, sum = 0; b != radix; ++b )
+            {
+                std::size_t const k = c[b];
+                c[b] = sum;
+                sum += k;
+            }
+
+            for ( std::size_t i = 0; i != n; ++i )
+            {
+                dst[ c[ ( address_of( src[i] ) >> ( 8 * d ) ) & 0xff ]++ ] = src[i];
+            }
+
+            std::swap( src, dst );
+        }
+
+        if ( src != first )
+        {
+            std::copy( src, src + n, first );
+        }
+    }
+} // namespace detail
+
+// sort_by_address: sort observers by the address they observe, in the order of operator<
+// and std::less, null first. Uses a radix sort unless there are few observers.
+
+template< class T >
+void sort_by_address( observer_ptr<T> * first, observer_ptr<T> * last )
+{
+    std::size_t const n = static_cast<std::size_t>( last - first );
+
+    if ( n < nsop_CONFIG_RADIX_SORT_THRESHOLD )
+    {
+        std::sort( first, last, []( observer_ptr<T> const & a, observer_ptr<T> const & b )
+        {
+            return std::less<T *>()( a.get(), b.get() );
+        } );
+    }
+    else
+    {
+        detail::radix_sort_address( first, n );
+    }
+}
+
+template< class T >
+void sort_by_address( std::vector< observer_ptr<T> > & v )
+{
+    sort_by_address( v.data(), v.data() + v.size() );
+}
+
+// unique_by_address: remove consecutive observers of the same address; for observers
+// sorted by address, the remaining ones are unique. The range version returns the new end
+// like std::unique(), the vector version erases the removed observers:
+
+template< class T >
+observer_ptr<T> * unique_by_address( observer_ptr<T> * first, observer_ptr<T> * last )
+{
+    return std::unique( first, last, []( observer_ptr<T> const & a, observer_ptr<T> const & b )
+    {
+        return a.get() == b.get();
+    } );
+}
+
+template< class T >
+void unique_by_address( std::vector< observer_ptr<T> > & v )
+{
+    v.erase( v.begin() + ( unique_by_address( v.data(), v.data() + v.size() ) - v.data() ), v.end() );
+}
+
+// page_group: the consecutive observers of objects that start in the same memory page:
+
+template< class T >
+struct page_group
+{
+    std::uintptr_t          page;       // address of the page
+    observer_ptr<T> const * first;
+    observer_ptr<T> const * last;
+
+    observer_ptr<T> const * begin() const nsop_noexcept { return first; }
+    observer_ptr<T> const * end()   const nsop_noexcept { return last; }
+    std::size_t             size()  const nsop_noexcept { return static_cast<std::size_t>( last - first ); }
+};
+
+// group_by_page: split observers sorted by address into groups per page; page_size must
+// be a power of two. The groups refer to the observers of the vector.
+
+template< class T >
+std::vector< page_group<T> > group_by_page( std::vector< observer_ptr<T> > const & sorted, std::size_t page_size = nsop_CONFIG_PAGE_SIZE )
+{
+    assert( page_size != 0 && ( page_size & ( page_size - 1 ) ) == 0 && "group_by_page: page size must be a power of two" );
+
+    std::uintptr_t const mask = ~static_cast<std::uintptr_t>( page_size - 1 );
+
+    std::vector< page_group<T> > groups;
+
+    observer_ptr<T> const * const last = sorted.data() + sorted.size();
+
+    for ( observer_ptr<T> const * pos = sorted.data(); pos != last; )
+    {
+        page_group<T> group = { detail::address_of( *pos ) & mask, pos, pos };
+
+        while ( pos != last && ( detail::address_of( *pos ) & mask ) == group.page )
+        {
+            ++pos;
+        }
+
+        group.last = pos;
+        groups.push_back( group );
+    }
+    return groups;
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::sort_by_address;
+using observer_ptr_lite::unique_by_address;
+using observer_ptr_lite::page_group;
+using observer_ptr_lite::group_by_page;
+
+} // namespace nonstd
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_SORT_H_INCLUDED
+
+// end of file
@@ -0,0 +1,301 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::variant_observer<>: observer of one of a closed set of types, with the type index in the low pointer bits, for C++11 onward.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#pragma once
+
+#ifndef NONSTD_OBSERVER_VARIANT_H_INCLUDED
+#define NONSTD_OBSERVER_VARIANT_H_INCLUDED
+
+#include "observer_ptr.hpp"
+
+#if nsop_CPP11_OR_GREATER
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+namespace nonstd { namespace observer_ptr_lite {
+
+namespace detail
+{
+    // Index of T in Ts, sizeof...(Ts) if T is not one of Ts:
+
+    template< class T, class... Ts >
+    struct type_index : std::integral_constant< std::size_t, 0 > {};
+
+    template< class T, class... Ts >
+    struct type_index< T, T, Ts... > : std::integral_constant< std::size_t, 0 > {};
+
+    template< class T, class U, class... Ts >
+    struct type_index< T, U, Ts... > : std::integral_constant< std::size_t, 1 + type_index< T, Ts... >::value > {};
+
+    // Whether Ts are distinct types:
+
+    template< class... Ts >
+    struct distinct_types : std::true_type {};
+
+    template< class T, class... Ts >
+    struct distinct_types< T, Ts... > : std::integral_constant< bool,
+        type_index< T, Ts... >::value == sizeof...( Ts ) && distinct_types< Ts... >::value > {};
+
+    template< class T, class... Ts >
+    struct first_type
+    {
+        typedef T type;
+    };
+
+    // Smallest alignment of the objects of types Ts:
+
+    template< class T, class... Ts >
+    struct min_alignment : address_alignment<T> {};
+
+    template< class T, class U, class... Ts >
+    struct min_alignment< T, U, Ts... > : std::integral_constant< std::size_t,
+        ( address_alignment<T>::value < min_alignment< U, Ts... >::value ? address_alignment<T>::value : min_alignment< U, Ts... >::value ) > {};
+
+    // Number of bits for an index of n alternatives:
+
+    inline constexpr unsigned index_bits( std::size_t n ) nsop_noexcept
+    {
+        return n < 2 ? 0 : 1 + index_bits( ( n + 1 ) / 2 );
+    }
+
+    // Call f with the observer of a T at address, an entry of the jump table of visit():
+
+    template< class R, class F, class T >
+    R visit_alternative( F & f, std::uintptr_t address )
+    {
+        return f( observer_ptr<T>( reinterpret_cast<T *>( address ) ) );
+    }
+} // namespace detail
+
+// variant_observer: observer of an object of one of the types Ts, in one word. The index of
+// the type of the object in Ts is stored in the low bits of the pointer that are zero due to
+// the alignment of all Ts. visit() calls a function with the observer_ptr of the actual type
+// via a jump table, without virtual functions or dynamic_cast. Access, comparison and
+// hashing are of the untagged address, as of an observer_ptr. A null variant_observer has
+// index 0 and holds none of Ts.
+
+template< class... Ts >
+class variant_observer
+{
+public:
+    static constexpr std::size_t alternatives = sizeof...( Ts );
+    static constexpr unsigned    index_bits   = detail::index_bits( sizeof...( Ts ) );
+
+    static_assert( sizeof...( Ts ) > 0, "variant_observer: expect at least one type" );
+    static_assert( detail::distinct_types< Ts... >::value, "variant_observer: types must be distinct" );
+
+    nsop_constexpr variant_observer() nsop_noexcept
+    : bits( 0 ) {}
+
+    nsop_constexpr variant_observer( std::nullptr_t ) nsop_noexcept
+    : bits( 0 ) {}
+
+    template< class T, class = typename std::enable_if< ( detail::type_index< T, Ts... >::value < sizeof...( Ts ) ) >::type >
+    explicit variant_observer( T * p ) nsop_noexcept
+    : bits( encode( p ) ) {}
+
+    template< class T, class = typename std::enable_if< ( detail::type_index< T, Ts... >::value < sizeof...( Ts ) ) >::type >
+    variant_observer( observer_ptr<T> p ) nsop_noexcept
+    : bits( encode( p.get() ) ) {}
+
+    // The index in Ts of the type of the observed object, 0 if null:
+
+    std::size_t index() const nsop_noexcept
+    {
+        return static_cast<std::size_t>( bits & index_mask );
+    }
+
+    // The untagged address:
+
+    void const * get() const nsop_noexcept
+    {
+        return reinterpret_cast<void const *>( address() );
+    }
+
+    explicit operator bool() const nsop_noexcept
+    {
+        return address() != 0;
+    }
+
+    // Whether the observed object is a T:
+
+    template< class T >
+    bool holds() const nsop_noexcept
+    {
+        return bits != 0 && index() == detail::type_index< T, Ts... >::value;
+    }
+
+    // The observer of the object if it is a T, else a null observer:
+
+    template< class T >
+    observer_ptr<T> get_if() const nsop_noexcept
+    {
+        static_assert( detail::type_index< T, Ts... >::value < sizeof...( Ts ), "variant_observer::get_if: T is not one of the types" );
+
+        return observer_ptr<T>( holds<T>() ? reinterpret_cast<T *>( address() ) : nsop_NULLPTR );
+    }
+
+    // f( observer_ptr<T>( p ) ) for the actual type T of the object; the result types must
+    // agree. Visiting a null variant_observer is the dereference of a null observer, checked
+    // per nsop_CONFIG_DEREF_CHECK; with nsop_DEREF_CHECK_NONE it is undefined behaviour:
+
+    template< class F >
+    auto visit( F && f ) const -> decltype( f( std::declval< observer_ptr< typename detail::first_type< Ts... >::type > >() ) )
+    {
+        typedef decltype( f( std::declval< observer_ptr< typename detail::first_type< Ts... >::type > >() ) ) result;
+        typedef result ( * alternative )( F &, std::uintptr_t );
+
+        static constexpr alternative table[] = { &detail::visit_alternative< result, F, Ts >... };
+
+        nsop_DEREF_CHECK( bits != 0 );
+        return table[ index() ]( f, address() );
+    }
+
+    void reset() nsop_noexcept
+    {
+        bits = 0;
+    }
+
+    void swap( variant_observer & other ) nsop_noexcept
+    {
+        using std::swap;
+        swap( bits, other.bits );
+    }
+
+private:
+    static constexpr std::uintptr_t index_mask = ( std::uintptr_t( 1 ) << index_bits ) - 1;
+
+    std::uintptr_t address() const nsop_noexcept
+    {
+        return bits & ~index_mask;
+    }
+
+    // The alignment is checked here, where Ts are complete, so that a variant_observer may be
+    // a member of one of Ts:
+
+    template< class T >
+    static std::uintptr_t encode( T * p ) nsop_noexcept
+    {
+        static_assert( index_bits <= detail::alignment_bits( detail::min_alignment< Ts... >::value ),
+            "variant_observer: more types than the alignment of the least aligned type leaves low pointer bits for" );
+
+        return p != nsop_NULLPTR ? reinterpret_cast<std::uintptr_t>( p ) | detail::type_index< T, Ts... >::value : 0;
+    }
+
+    std::uintptr_t bits;
+};
+
+template< class... Ts > constexpr std::size_t variant_observer<Ts...>::alternatives;
+template< class... Ts > constexpr unsigned    variant_observer<Ts...>::index_bits;
+
+// specialized algorithms:
+
+template< class... Ts >
+void swap( variant_observer<Ts...> & p1, variant_observer<Ts...> & p2 ) nsop_noexcept
+{
+    p1.swap( p2 );
+}
+
+template< class F, class... Ts >
+auto visit( F && f, variant_observer<Ts...> v ) -> decltype( v.visit( std::forward<F>( f ) ) )
+{
+    return v.visit( std::forward<F>( f ) );
+}
+
+template< class... Ts >
+bool operator==( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return p1.get() == p2.get();
+}
+
+template< class... Ts >
+bool operator!=( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return !( p1 == p2 );
+}
+
+template< class... Ts >
+bool operator==( variant_observer<Ts...> p, std::nullptr_t ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class... Ts >
+bool operator==( std::nullptr_t, variant_observer<Ts...> p ) nsop_noexcept
+{
+    return !p;
+}
+
+template< class... Ts >
+bool operator!=( variant_observer<Ts...> p, std::nullptr_t ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class... Ts >
+bool operator!=( std::nullptr_t, variant_observer<Ts...> p ) nsop_noexcept
+{
+    return static_cast<bool>( p );
+}
+
+template< class... Ts >
+bool operator<( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return std::less< void const * >()( p1.get(), p2.get() );
+}
+
+template< class... Ts >
+bool operator>( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return p2 < p1;
+}
+
+template< class... Ts >
+bool operator<=( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return !( p2 < p1 );
+}
+
+template< class... Ts >
+bool operator>=( variant_observer<Ts...> p1, variant_observer<Ts...> p2 ) nsop_noexcept
+{
+    return !( p1 < p2 );
+}
+
+} // namespace observer_ptr_lite
+
+// provide in namespace nonstd:
+
+using observer_ptr_lite::variant_observer;
+using observer_ptr_lite::visit;
+
+} // namespace nonstd
+
+namespace std
+{
+
+template< class... Ts >
+struct hash< ::nonstd::variant_observer<Ts...> >
+{
+    size_t operator()( ::nonstd::variant_observer<Ts...> p ) const nsop_noexcept
+    {
+        return ::nonstd::observer_ptr_lite::detail::hash_address( p.get() );
+    }
+};
+
+}
+
+#endif // nsop_CPP11_OR_GREATER
+
+#endif // NONSTD_OBSERVER_VARIANT_H_INCLUDED
+
+// end of file
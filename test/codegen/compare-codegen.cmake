@@ -0,0 +1,133 @@
+# Copyright 2026-2026 by Martin Moene
+#
+# https://github.com/martinmoene/observer-ptr-lite
+#
+# Distributed under the Boost Software License, Version 1.0.
+# (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+#
+# Compare the generated code of function pairs nsop_cg_observer_<name> and nsop_cg_raw_<name>.
+#
+# Usage: cmake -D ASM=<file.s> [-D STAMP=<file>] -P compare-codegen.cmake
+#
+# The assembly is normalized before comparison: assembler directives and comments are
+# removed and local labels are renumbered in order of appearance per function.
+# The script fails if the normalized code of any pair differs, or if a pair is incomplete.
+# STAMP, if given, is written when all pairs match.
+
+if( NOT ASM )
+    message( FATAL_ERROR "compare-codegen: specify assembly file via -D ASM=<file.s>" )
+endif()
+
+file( READ "${ASM}" content )
+
+# Protect list separators, then split into lines:
+
+string( REPLACE ";"  "<semicolon>" content "${content}" )
+string( REPLACE "\n" ";"           content "${content}" )
+
+set( functions "" )
+set( current   "" )
+
+foreach( line IN LISTS content )
+    # Start of a function (ELF or Mach-O symbol):
+    if( line MATCHES "^_?(nsop_cg_(observer|raw)_[A-Za-z0-9_]+):" )
+        set( current "${CMAKE_MATCH_1}" )
+        set( body_${current} "" )
+        list( APPEND functions "${current}" )
+        continue()
+    endif()
+
+    if( NOT current )
+        continue()
+    endif()
+
+    # End of the function: end-of-procedure or size directive, or another global symbol:
+    if( line MATCHES "^[ \t]*\\.(cfi_endproc|size)([ \t]|$)" OR
+        ( line MATCHES "^_?[A-Za-z_][A-Za-z0-9_$]*:" AND NOT line MATCHES "^L[A-Za-z]*[0-9_]+:" ) )
+        set( current "" )
+        continue()
+    endif()
+
+    # Drop comments, directives and empty lines; keep local labels:
+    string( REGEX REPLACE "[ \t]+(#|//)[ \t].*$" "" line "${line}" )
+    string( REGEX REPLACE "[ \t]+$" "" line "${line}" )
+
+    if( line STREQUAL "" OR line MATCHES "^[ \t]*(#|//)" )
+        continue()
+    endif()
+
+    if( line MATCHES "^[ \t]*\\." AND NOT line MATCHES "^[ \t]*\\.L[A-Za-z0-9_]*:" )
+        continue()
+    endif()
+
+    string( REGEX REPLACE "^[ \t]+" "" line "${line}" )
+    string( REGEX REPLACE "[ \t]+" " " line "${line}" )
+
+    string( APPEND body_${current} "${line}\n" )
+endforeach()
+
+# Renumber local labels (.L3, .LBB0_2, LBB0_2, LCPI0_0) in order of appearance:
+
+function( normalize_labels body result )
+    string( REGEX MATCHALL "(\\.L[A-Za-z0-9_]+|LBB[0-9_]+|LCPI[0-9_]+)" labels "${body}" )
+    list( REMOVE_DUPLICATES labels )
+
+    set( index 0 )
+    foreach( label IN LISTS labels )
+        string( REPLACE "." "\\." pattern "${label}" )
+        string( REGEX REPLACE "${pattern}([^A-Za-z0-9_])" "<label${index}>\\1" body "${body}" )
+        math( EXPR index "${index} + 1" )
+    endforeach()
+
+    set( ${result} "${body}" PARENT_SCOPE )
+endfunction()
+
+# Compare each observer function with its raw pointer counterpart:
+
+set( pairs      0 )
+set( mismatches "" )
+
+foreach( fn IN LISTS functions )
+    if( NOT fn MATCHES "^nsop_cg_observer_(.+)$" )
+        continue()
+    endif()
+
+    set( name "${CMAKE_MATCH_1}" )
+    set( raw  "nsop_cg_raw_${name}" )
+
+    if( NOT DEFINED body_${raw} )
+        list( APPEND mismatches "${name}" )
+        message( "compare-codegen: ${name}: missing '${raw}'" )
+        continue()
+    endif()
+
+    normalize_labels( "${body_${fn}}" observer_code )
+    normalize_labels( "${body_${raw}}"      raw_code      )
+
+    math( EXPR pairs "${pairs} + 1" )
+
+    if( observer_code STREQUAL raw_code )
+        message( STATUS "compare-codegen: ${name}: same" )
+    else()
+        list( APPEND mismatches "${name}" )
+        string( REPLACE "<semicolon>" ";" observer_code "${observer_code}" )
+        string( REPLACE "<semicolon>" ";" raw_code      "${raw_code}"      )
+        message( "compare-codegen: ${name}: differs\n-- observer_ptr<T>:\n${observer_code}-- T*:\n${raw_code}" )
+    endif()
+endforeach()
+
+if( pairs EQUAL 0 )
+    message( FATAL_ERROR "compare-codegen: no function pairs found in '${ASM}'" )
+endif()
+
+if( mismatches )
+    message( FATAL_ERROR "compare-codegen: observer_ptr<T> code differs from T* code for: ${mismatches}" )
+endif()
+
+message( STATUS "compare-codegen: all ${pairs} function pairs generate the same code" )
+
+if( STAMP )
+    file( TOUCH "${STAMP}" )
+endif()
+
+# end of file
@@ -0,0 +1,101 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+// Code generation parity: each function nsop_cg_observer_<name> performs an operation via
+// observer_ptr<T> and must compile to the same instructions as its counterpart
+// nsop_cg_raw_<name> that performs the same operation on T*. See compare-codegen.cmake.
+//
+// Both variants take raw pointers or structs in memory, so that the comparison is about
+// the code for the observer_ptr operations, not about how the ABI passes a class type.
+
+#include "nonstd/observer_ptr.hpp"
+
+using nonstd::observer_ptr;
+using nonstd::make_observer;
+#if nsop_CPP11_OR_GREATER
+using nonstd::nonnull_observer_ptr;
+#endif
+
+struct S { int a; int b; };
+
+struct ObserverPair { observer_ptr<int> p; observer_ptr<int> q; };
+struct RawPair      { int *             p; int *             q; };
+
+extern "C" {
+
+// Access:
+
+int * nsop_cg_observer_get( int * p ) { return make_observer( p ).get(); }
+int * nsop_cg_raw_get     ( int * p ) { return p; }
+
+int nsop_cg_observer_deref( int * p ) { return *make_observer( p ); }
+int nsop_cg_raw_deref     ( int * p ) { return *p; }
+
+int nsop_cg_observer_arrow( S * p ) { return make_observer( p )->b; }
+int nsop_cg_raw_arrow     ( S * p ) { return p->b; }
+
+// Conversion to bool, via the safe bool idiom for C++98:
+
+int nsop_cg_observer_bool( int * p ) { return make_observer( p ) ? *make_observer( p ) : -1; }
+int nsop_cg_raw_bool     ( int * p ) { return p ? *p : -1; }
+
+int nsop_cg_observer_not( int * p ) { return !make_observer( p ); }
+int nsop_cg_raw_not     ( int * p ) { return !p; }
+
+// Modifiers:
+
+void nsop_cg_observer_swap( ObserverPair * s ) { swap( s->p, s->q ); }
+void nsop_cg_raw_swap     ( RawPair      * s ) { std::swap( s->p, s->q ); }
+
+void nsop_cg_observer_reset( ObserverPair * s, int * p ) { s->p.reset( p ); }
+void nsop_cg_raw_reset     ( RawPair      * s, int * p ) { s->p = p; }
+
+int * nsop_cg_observer_release( ObserverPair * s ) { return s->p.release(); }
+int * nsop_cg_raw_release     ( RawPair      * s ) { int * p = s->p; s->p = nsop_NULLPTR; return p; }
+
+// Comparison:
+
+bool nsop_cg_observer_equal( int * p, int * q ) { return make_observer( p ) == make_observer( q ); }
+bool nsop_cg_raw_equal     ( int * p, int * q ) { return p == q; }
+
+bool nsop_cg_observer_not_equal( int * p, int * q ) { return make_observer( p ) != make_observer( q ); }
+bool nsop_cg_raw_not_equal     ( int * p, int * q ) { return p != q; }
+
+#if nsop_HAVE_NULLPTR
+bool nsop_cg_observer_equal_nullptr( int * p ) { return make_observer( p ) == nullptr; }
+bool nsop_cg_raw_equal_nullptr     ( int * p ) { return p == nullptr; }
+#endif
+
+bool nsop_cg_observer_less( int * p, int * q ) { return make_observer( p ) < make_observer( q ); }
+bool nsop_cg_raw_less     ( int * p, int * q ) { return std::less<int *>()( p, q ); }
+
+bool nsop_cg_observer_less_equal( int * p, int * q ) { return make_observer( p ) <= make_observer( q ); }
+bool nsop_cg_raw_less_equal     ( int * p, int * q ) { return !std::less<int *>()( q, p ); }
+
+bool nsop_cg_observer_greater( int * p, int * q ) { return make_observer( p ) > make_observer( q ); }
+bool nsop_cg_raw_greater     ( int * p, int * q ) { return std::less<int *>()( q, p ); }
+
+bool nsop_cg_observer_greater_equal( int * p, int * q ) { return make_observer( p ) >= make_observer( q ); }
+bool nsop_cg_raw_greater_equal     ( int * p, int * q ) { return !std::less<int *>()( p, q ); }
+
+// Ordering of observers with a related watched type, via detail::common_type:
+
+#if nsop_HAVE_OWN_COMMON_TYPE_STD
+bool nsop_cg_observer_less_related( int * p, int const * q ) { return make_observer( p ) < make_observer( q ); }
+bool nsop_cg_raw_less_related     ( int * p, int const * q ) { return std::less<int const *>()( p, q ); }
+#endif
+
+// A non-null observer removes the null check of an observer_ptr converted from it:
+
+#if nsop_CPP11_OR_GREATER
+int nsop_cg_observer_nonnull( int * p ) { observer_ptr<int> o = nonnull_observer_ptr<int>( p ); return o ? *o : -1; }
+int nsop_cg_raw_nonnull     ( int * p ) { return *p; }
+#endif
+
+} // extern "C"
+
+// end of file
@@ -0,0 +1,195 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_atomic.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <thread>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+struct Node
+{
+    int value;
+    observer_ptr<Node> next;
+};
+
+#endif
+
+CASE( "atomic_observer_ptr: Is always lock-free and has the size of a pointer" " [atomic][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    atomic_observer_ptr<int> p;
+
+    EXPECT( atomic_observer_ptr<int>::is_always_lock_free );
+    EXPECT( p.is_lock_free() );
+    EXPECT( sizeof( atomic_observer_ptr<int> ) == sizeof( int * ) );
+#else
+    EXPECT( !!"atomic_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_observer_ptr: Allows to load and store" " [atomic][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    atomic_observer_ptr<int> n;
+    atomic_observer_ptr<int> p( &a );
+    atomic_observer_ptr<int> q( make_observer( &a ) );
+
+    EXPECT( n.load().get() == static_cast<int *>( nullptr ) );
+    EXPECT( p.load().get() == &a );
+    EXPECT( q.load( std::memory_order_acquire ).get() == &a );
+
+    p.store( make_observer( &b ) );
+
+    EXPECT( p.load().get() == &b );
+
+    p.store( make_observer( &a ), std::memory_order_release );
+
+    EXPECT( p.load( std::memory_order_relaxed ).get() == &a );
+
+    p = make_observer( &b );
+    observer_ptr<int> o = p;
+
+    EXPECT( o.get() == &b );
+#else
+    EXPECT( !!"atomic_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_observer_ptr: Allows to exchange" " [atomic][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    atomic_observer_ptr<int> p( &a );
+
+    EXPECT( p.exchange( make_observer( &b ) ).get() == &a );
+    EXPECT( p.exchange( make_observer( &a ), std::memory_order_acq_rel ).get() == &b );
+    EXPECT( p.load().get() == &a );
+#else
+    EXPECT( !!"atomic_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_observer_ptr: Allows to compare and exchange" " [atomic][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    atomic_observer_ptr<int> p( &a );
+    observer_ptr<int> expected( &b );
+
+    EXPECT_NOT( p.compare_exchange_strong( expected, make_observer( &b ) ) );
+    EXPECT( expected.get() == &a );
+    EXPECT( p.compare_exchange_strong( expected, make_observer( &b ), std::memory_order_acq_rel, std::memory_order_acquire ) );
+    EXPECT( p.load().get() == &b );
+
+    while ( !p.compare_exchange_weak( expected, make_observer( &a ), std::memory_order_release, std::memory_order_relaxed ) ) {}
+
+    EXPECT( expected.get() == &b );
+    EXPECT( p.load().get() == &a );
+#else
+    EXPECT( !!"atomic_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_observer_ptr: Allows to push concurrently onto a list" " [atomic][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    enum { threads = 4, count = 1000 };
+
+    std::vector<Node> nodes( threads * count );
+    std::vector<std::thread> workers;
+    atomic_observer_ptr<Node> head;
+
+    for ( int t = 0; t != threads; ++t )
+    {
+        workers.emplace_back( [&nodes, &head, t]()
+        {
+            for ( int i = 0; i != count; ++i )
+            {
+                Node & node = nodes[ static_cast<std::size_t>( t * count + i ) ];
+                node.value = 1;
+                node.next  = head.load( std::memory_order_relaxed );
+
+                while ( !head.compare_exchange_weak( node.next, make_observer( &node ), std::memory_order_release, std::memory_order_relaxed ) ) {}
+            }
+        } );
+    }
+
+    for ( auto & worker : workers )
+    {
+        worker.join();
+    }
+
+    int sum = 0;
+    for ( observer_ptr<Node> p = head.load( std::memory_order_acquire ); p; p = p->next )
+    {
+        sum += p->value;
+    }
+
+    EXPECT( sum == threads * count );
+#else
+    EXPECT( !!"atomic_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "atomic_observer_ref: Allows atomic access to an observer_ptr in an existing object" " [atomic][extension]" )
+{
+#if nsop_HAVE_ATOMIC_OBSERVER_REF
+    Node a = { 7, observer_ptr<Node>() };
+    Node b = { 9, observer_ptr<Node>() };
+
+    atomic_observer_ref<Node> next( a.next );
+
+    EXPECT( atomic_observer_ref<Node>::is_always_lock_free );
+    EXPECT( next.is_lock_free() );
+    EXPECT( next.load().get() == static_cast<Node *>( nullptr ) );
+
+    next.store( make_observer( &b ), std::memory_order_release );
+
+    EXPECT( a.next.get() == &b );
+    EXPECT( next.load( std::memory_order_acquire )->value == 9 );
+    EXPECT( make_atomic_observer_ref( a.next ).exchange( make_observer( &a ) ).get() == &b );
+    EXPECT( a.next.get() == &a );
+#else
+    EXPECT( !!"atomic_observer_ref is not available (no C++11, or no atomic_ref and no atomic builtins)" );
+#endif
+}
+
+CASE( "atomic_observer_ref: Allows to compare and exchange an observer_ptr in an existing object" " [atomic][extension]" )
+{
+#if nsop_HAVE_ATOMIC_OBSERVER_REF
+    int x = 7, y = 9;
+    observer_ptr<int> field( &x );
+    atomic_observer_ref<int> ref( field );
+    observer_ptr<int> expected( &y );
+
+    EXPECT_NOT( ref.compare_exchange_strong( expected, make_observer( &y ) ) );
+    EXPECT( expected.get() == &x );
+    EXPECT( ref.compare_exchange_strong( expected, make_observer( &y ), std::memory_order_acq_rel ) );
+    EXPECT( field.get() == &y );
+
+    while ( !ref.compare_exchange_weak( expected, make_observer( &x ), std::memory_order_relaxed, std::memory_order_relaxed ) ) {}
+
+    EXPECT( field.get() == &x );
+#else
+    EXPECT( !!"atomic_observer_ref is not available (no C++11, or no atomic_ref and no atomic builtins)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -0,0 +1,170 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_bulk.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <algorithm>
+# include <string>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Observers of arr, null where pattern has a bit clear, for all array sizes up to 37:
+
+std::vector< observer_ptr<int> > make_observers( int * arr, std::size_t n, unsigned long long pattern )
+{
+    std::vector< observer_ptr<int> > v;
+
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        v.push_back( ( pattern >> ( i % 64 ) ) & 1u ? make_observer( arr + i ) : observer_ptr<int>() );
+    }
+    return v;
+}
+
+unsigned long long const patterns[] = { 0ull, ~0ull, 0x5555555555555555ull, 0x0f0f00ff000f00f1ull, 0x8000000000000001ull, };
+
+#endif
+
+CASE( "count_nonnull: Counts the non-null observers" " [bulk][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[37] = {};
+    bool same = true;
+
+    for ( unsigned long long pattern : patterns )
+    {
+        for ( std::size_t n = 0; n <= 37; ++n )
+        {
+            std::vector< observer_ptr<int> > v = make_observers( arr, n, pattern );
+            observer_ptr<int> const * first = v.data();
+
+            same = same && count_nonnull( first, first + n )
+                == static_cast<std::size_t>( std::count_if( v.begin(), v.end(), []( observer_ptr<int> p ) { return !!p; } ) );
+        }
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"count_nonnull is not available (no C++11)" );
+#endif
+}
+
+CASE( "find: Finds the first observer equal to a value, or the first null observer" " [bulk][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[37] = {};
+    bool same = true;
+
+    for ( unsigned long long pattern : patterns )
+    {
+        for ( std::size_t n = 0; n <= 37; ++n )
+        {
+            std::vector< observer_ptr<int> > v = make_observers( arr, n, pattern );
+            observer_ptr<int> * first = v.data();
+            observer_ptr<int> * last  = first + n;
+
+            same = same && find_first_null( first, last ) - first == std::find( v.begin(), v.end(), nullptr ) - v.begin();
+
+            for ( std::size_t k = 0; k != n; ++k )
+            {
+                observer_ptr<int> const value = make_observer( arr + k );
+                observer_ptr<int> const * cfirst = first;
+
+                same = same && find( cfirst, cfirst + n, value ) - cfirst == std::find( v.begin(), v.end(), value ) - v.begin();
+                same = same && contains( cfirst, cfirst + n, value ) == ( std::find( v.begin(), v.end(), value ) != v.end() );
+            }
+        }
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"find is not available (no C++11)" );
+#endif
+}
+
+CASE( "find: Is found for observers of a type in namespace std" " [bulk][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::string s;
+    std::vector< observer_ptr<std::string> > v( 5 );
+    v[3] = make_observer( &s );
+
+    EXPECT( find( v.data(), v.data() + v.size(), make_observer( &s ) ) == v.data() + 3 );
+    EXPECT( find_first_null( v.data() + 3, v.data() + v.size() ) == v.data() + 4 );
+#else
+    EXPECT( !!"find is not available (no C++11)" );
+#endif
+}
+
+CASE( "all_of_equal: Tells if all observers are equal to a value" " [bulk][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    bool same = true;
+
+    for ( std::size_t n = 0; n <= 37; ++n )
+    {
+        for ( std::size_t k = 0; k <= n; ++k )
+        {
+            std::vector< observer_ptr<int> > v( n, make_observer( &a ) );
+
+            if ( k != n )
+                v[k].reset();
+
+            observer_ptr<int> const * first = v.data();
+
+            same = same && all_of_equal( first, first + n, make_observer( &a ) ) == ( k == n );
+            same = same && all_of_equal( first, first + n, observer_ptr<int>() ) == ( n == 0 || ( n == 1 && k == 0 ) );
+        }
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"all_of_equal is not available (no C++11)" );
+#endif
+}
+
+CASE( "compact_nonnull: Moves the non-null observers to the front, keeping their order" " [bulk][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[37] = {};
+    bool same = true;
+
+    for ( unsigned long long pattern : patterns )
+    {
+        for ( std::size_t n = 0; n <= 37; ++n )
+        {
+            std::vector< observer_ptr<int> > v = make_observers( arr, n, pattern );
+            std::vector< observer_ptr<int> > expected( v );
+
+            expected.erase( std::remove( expected.begin(), expected.end(), nullptr ), expected.end() );
+
+            observer_ptr<int> * last = compact_nonnull( v.data(), v.data() + n );
+
+            same = same && static_cast<std::size_t>( last - v.data() ) == expected.size()
+                        && std::equal( expected.begin(), expected.end(), v.data() );
+        }
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"compact_nonnull is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
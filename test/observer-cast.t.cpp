@@ -0,0 +1,148 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_cast.hpp"
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// A hierarchy with multiple, virtual and repeated bases, so that casts adjust the pointer:
+
+struct Shape           { virtual ~Shape() {} long s = 0; };
+struct Named           { virtual ~Named() {} long n = 0; };
+struct Circle   : Shape, Named { long c = 0; };
+struct Disc     : Circle { long d = 0; };
+struct Square   : Shape { long q = 0; };
+
+struct Node            { virtual ~Node() {} long v = 0; };
+struct Left     : virtual Node { long l = 0; };
+struct Right    : virtual Node { long r = 0; };
+struct Joined   : Left, Right { long j = 0; };
+
+struct Part            { virtual ~Part() {} long p = 0; };
+struct PartA    : Part { long a = 0; };
+struct PartB    : Part { long b = 0; };
+struct Twice    : PartA, PartB { long t = 0; };       // two Part subobjects
+
+// Whether dynamic_observer_cast<T> agrees with dynamic_cast<T*>, twice for the cached path:
+
+template< class T, class U >
+bool same_as_dynamic_cast( U * p )
+{
+    return dynamic_observer_cast<T>( make_observer( p ) ).get() == dynamic_cast<T *>( p )
+        && dynamic_observer_cast<T>( make_observer( p ) ).get() == dynamic_cast<T *>( p );
+}
+
+#endif
+
+CASE( "static_observer_cast: Allows to cast an observer as static_cast" " [cast][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Circle circle;
+    observer_ptr<Named> named = make_observer<Named>( &circle );
+
+    EXPECT( static_observer_cast<Circle>( named ).get() == &circle );
+    EXPECT( ( static_observer_cast<Named>( make_observer( &circle ) ) == named ) );
+    EXPECT( !static_observer_cast<Circle>( observer_ptr<Named>() ) );
+#else
+    EXPECT( !!"static_observer_cast is not available (no C++11)" );
+#endif
+}
+
+CASE( "const_observer_cast, reinterpret_observer_cast: Allow to cast an observer as const_cast, reinterpret_cast" " [cast][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    long value = 42;
+    observer_ptr<long const> p = make_observer<long const>( &value );
+
+    EXPECT( const_observer_cast<long>( p ).get() == &value );
+    EXPECT( reinterpret_observer_cast<char const>( p ).get() == reinterpret_cast<char const *>( &value ) );
+    EXPECT( reinterpret_observer_cast<long const>( reinterpret_observer_cast<char const>( p ) ) == p );
+#else
+    EXPECT( !!"const_observer_cast is not available (no C++11)" );
+#endif
+}
+
+CASE( "dynamic_observer_cast: Allows to downcast and cross-cast as dynamic_cast" " [cast][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Circle circle;
+    Disc disc;
+    Square square;
+
+    Shape * const shapes[] = { &circle, &disc, &square };
+
+    bool same = true;
+
+    for ( Shape * shape : shapes )
+    {
+        same = same && same_as_dynamic_cast< Circle       >( shape );
+        same = same && same_as_dynamic_cast< Disc         >( shape );
+        same = same && same_as_dynamic_cast< Square       >( shape );
+        same = same && same_as_dynamic_cast< Named        >( shape );
+        same = same && same_as_dynamic_cast< Named const  >( static_cast<Shape const *>( shape ) );
+    }
+
+    Named * const names[] = { &circle, &disc };
+
+    for ( Named * name : names )
+    {
+        same = same && same_as_dynamic_cast< Shape  >( name );
+        same = same && same_as_dynamic_cast< Circle >( name );
+        same = same && same_as_dynamic_cast< Disc   >( name );
+    }
+
+    EXPECT( same );
+    EXPECT( dynamic_observer_cast<Named>( make_observer<Shape>( &disc ) ).get() == static_cast<Named *>( &disc ) );
+    EXPECT( !dynamic_observer_cast<Circle>( make_observer<Shape>( &square ) ) );
+    EXPECT( !dynamic_observer_cast<Circle>( observer_ptr<Shape>() ) );
+    EXPECT( dynamic_observer_cast<Shape>( make_observer( &disc ) ).get() == static_cast<Shape *>( &disc ) );
+#else
+    EXPECT( !!"dynamic_observer_cast is not available (no C++11)" );
+#endif
+}
+
+CASE( "dynamic_observer_cast: Allows to cast from virtual and repeated bases as dynamic_cast" " [cast][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Joined joined;
+    Left left;
+    Twice twice;
+
+    bool same = true;
+
+    same = same && same_as_dynamic_cast< Joined >( static_cast<Node *>( &joined ) );
+    same = same && same_as_dynamic_cast< Right  >( static_cast<Node *>( &joined ) );
+    same = same && same_as_dynamic_cast< Right  >( static_cast<Left *>( &joined ) );
+    same = same && same_as_dynamic_cast< Left   >( static_cast<Node *>( &left ) );
+    same = same && same_as_dynamic_cast< Joined >( static_cast<Node *>( &left ) );
+
+    // the result depends on which Part subobject is cast:
+
+    Part * const a = static_cast<PartA *>( &twice );
+    Part * const b = static_cast<PartB *>( &twice );
+
+    same = same && same_as_dynamic_cast< PartA >( a ) && same_as_dynamic_cast< PartB >( a );
+    same = same && same_as_dynamic_cast< PartA >( b ) && same_as_dynamic_cast< PartB >( b );
+    same = same && same_as_dynamic_cast< Twice >( a ) && same_as_dynamic_cast< Twice >( b );
+
+    EXPECT( same );
+    EXPECT( dynamic_observer_cast<PartB>( make_observer( a ) ).get() == static_cast<PartB *>( &twice ) );
+    EXPECT( dynamic_observer_cast<Joined>( make_observer<Node>( &joined ) ).get() == &joined );
+#else
+    EXPECT( !!"dynamic_observer_cast is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
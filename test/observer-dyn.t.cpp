@@ -0,0 +1,193 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_dyn.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <set>
+# include <unordered_set>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Unrelated types without virtual functions:
+
+struct Square
+{
+    double side;
+
+    double area() const     { return side * side; }
+    void scale( double f )  { side *= f; }
+};
+
+struct Rect
+{
+    double width, height;
+
+    double area() const     { return width * height; }
+    void scale( double f )  { width *= f; height *= f; }
+};
+
+// The interface: the function table, the table of a type and the member functions:
+
+struct Shape
+{
+    struct table
+    {
+        double ( * area  )( void const * self );
+        void   ( * scale )( void * self, double f );
+    };
+
+    template< class T > static double area_of( void const * self ) { return static_cast<T const *>( self )->area(); }
+    template< class T > static void  scale_of( void * self, double f ) { static_cast<T *>( self )->scale( f ); }
+
+    template< class T >
+    static constexpr table table_for()
+    {
+        return table{ &area_of<T>, &scale_of<T> };
+    }
+
+    template< class Self >
+    struct methods
+    {
+        double area() const         { return static_cast<Self const &>( *this ).call( &table::area ); }
+        void   scale( double f ) const { static_cast<Self const &>( *this ).call( &table::scale, f ); }
+    };
+};
+
+// An interface without member functions:
+
+struct Area
+{
+    struct table
+    {
+        double ( * area )( void const * self );
+    };
+
+    template< class T >
+    static constexpr table table_for()
+    {
+        return table{ &Shape::area_of<T> };
+    }
+};
+
+double total_area( dyn_observer<Shape> const * shapes, std::size_t n )
+{
+    double sum = 0;
+
+    for ( std::size_t i = 0; i != n; ++i )
+        sum += shapes[i].area();
+
+    return sum;
+}
+
+#endif
+
+CASE( "dyn_observer: Allows to use unrelated types via one interface" " [dyn][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Square square = { 2 };
+    Rect rect = { 2, 3 };
+
+    dyn_observer<Shape> const shapes[] = { make_observer( &square ), make_observer( &rect ) };
+
+    EXPECT( sizeof( dyn_observer<Shape> ) == 2 * sizeof( void * ) );
+    EXPECT( total_area( shapes, 2 ) == 10 );
+
+    shapes[0].scale( 2 );
+    shapes[1].call( &Shape::table::scale, 0.5 );
+
+    EXPECT( square.side == 4 );
+    EXPECT( rect.width == 1 );
+    EXPECT( total_area( shapes, 2 ) == 17.5 );
+    EXPECT( shapes[1].get() == static_cast<void *>( &rect ) );
+    EXPECT( ( shapes[1].table().area == &Shape::area_of<Rect> ) );
+#else
+    EXPECT( !!"dyn_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "dyn_observer: Allows an interface without member functions and const objects" " [dyn][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Rect const rect = { 2, 3 };
+    dyn_observer<Area const> a( &rect );
+
+    EXPECT( a.call( &Area::table::area ) == 6 );
+    EXPECT( a.get() == static_cast<void const *>( &rect ) );
+#else
+    EXPECT( !!"dyn_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "dyn_observer: Observes a const object only via an interface const, that calls functions that take void const *" " [dyn][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Square square = { 2 };
+    Square const & csquare = square;
+
+    dyn_observer<Shape> const shape( &square );
+    dyn_observer<Shape const> const cshape( &csquare );
+    dyn_observer<Shape const> const converted = shape;
+
+    EXPECT( cshape.area() == 4 );
+    EXPECT( converted.area() == 4 );
+    EXPECT( cshape.get() == converted.get() );
+    EXPECT( ( std::is_same< decltype( cshape.get() ), void const * >::value ) );
+    EXPECT( ( std::is_constructible< dyn_observer<Shape const>, Square * >::value ) );
+    EXPECT( ( !std::is_constructible< dyn_observer<Shape>, Square const * >::value ) );
+    EXPECT( ( !std::is_convertible< observer_ptr<Square const>, dyn_observer<Shape> >::value ) );
+    EXPECT( ( !std::is_convertible< dyn_observer<Shape const>, dyn_observer<Shape> >::value ) );
+#else
+    EXPECT( !!"dyn_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "dyn_observer: Is null by default and compares and hashes as the object address" " [dyn][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Square squares[2] = { { 1 }, { 2 } };
+
+    dyn_observer<Shape> null;
+    dyn_observer<Shape> const s0 = make_observer( &squares[0] );
+    dyn_observer<Shape> const s1( &squares[1] );
+
+    EXPECT( !null );
+    EXPECT( ( null == nullptr ) );
+    EXPECT( !dyn_observer<Shape>( observer_ptr<Square>() ) );
+    EXPECT( ( s0 != nullptr ) );
+    EXPECT( ( s0 == dyn_observer<Shape>( &squares[0] ) ) );
+    EXPECT( ( s0 != s1 ) );
+    EXPECT( ( s0 < s1 ) );
+    EXPECT( ( s1 > s0 ) );
+    EXPECT( ( s0 <= s0 ) );
+    EXPECT( ( s1 >= s1 ) );
+
+    std::set< dyn_observer<Shape> > ordered = { s1, s0, s1 };
+    std::unordered_set< dyn_observer<Shape> > hashed = { s1, s0, s1 };
+
+    EXPECT( ordered.size() == 2u );
+    EXPECT( hashed.count( s0 ) == 1u );
+
+    dyn_observer<Shape> s = s0;
+    s.reset();
+
+    EXPECT( !s );
+#else
+    EXPECT( !!"dyn_observer is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
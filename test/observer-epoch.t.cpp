@@ -0,0 +1,264 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_epoch.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <thread>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Reclamation marks an object dead instead of deleting it, so that a test can
+// detect access to a reclaimed object without undefined behaviour:
+
+struct Item
+{
+    std::atomic<bool> alive;
+    int value;
+
+    Item() : alive( true ), value( 0 ) {}
+};
+
+std::atomic<int> reclaimed( 0 );
+
+struct mark_dead
+{
+    void operator()( Item * p ) const
+    {
+        p->alive.store( false, std::memory_order_relaxed );
+        reclaimed.fetch_add( 1, std::memory_order_relaxed );
+    }
+};
+
+#endif
+
+CASE( "epoch_guard: Allows to load observers while pinned" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    epoch_domain domain;
+    Item a;
+    a.value = 7;
+
+    atomic_observer_ptr<Item> src( &a );
+    std::atomic<Item *> raw( &a );
+
+    epoch_guard guard = domain.pin();
+
+    observer_ptr<Item> p = guard.load( src );
+    observer_ptr<Item> q = guard.load( raw );
+
+    EXPECT( p.get() == &a );
+    EXPECT( q.get() == &a );
+    EXPECT( p->value == 7 );
+    EXPECT( guard.epoch() == domain.epoch() );
+#else
+    EXPECT( !!"epoch_guard is not available (no C++11)" );
+#endif
+}
+
+CASE( "epoch_guard: Allows to nest guards" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    epoch_domain domain;
+    Item a;
+
+    reclaimed = 0;
+    {
+        epoch_guard outer( domain );
+        {
+            epoch_guard inner( domain );
+            domain.retire<Item, mark_dead>( &a );
+        }
+        domain.collect();
+        domain.collect();
+        domain.collect();
+
+        EXPECT( reclaimed == 0 );
+    }
+    domain.collect();
+    domain.collect();
+
+    EXPECT( reclaimed == 1 );
+#else
+    EXPECT( !!"epoch_guard is not available (no C++11)" );
+#endif
+}
+
+CASE( "epoch_domain: Reclaims a retired object two epochs later" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    epoch_domain domain;
+    Item a;
+
+    reclaimed = 0;
+
+    std::uint64_t const retired = domain.epoch();
+    domain.retire<Item, mark_dead>( &a );
+
+    while ( domain.epoch() < retired + 2 )
+    {
+        EXPECT( reclaimed == 0 );
+        domain.collect();
+    }
+
+    EXPECT( reclaimed == 1 );
+    EXPECT( !a.alive.load() );
+#else
+    EXPECT( !!"epoch_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "epoch_domain: Does not advance the epoch past a thread pinned to an earlier epoch" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    epoch_domain domain;
+    Item a;
+    std::atomic<bool> pinned( false );
+    std::atomic<bool> done( false );
+
+    reclaimed = 0;
+
+    std::thread reader( [&]()
+    {
+        epoch_guard guard( domain );
+        pinned = true;
+        while ( !done ) { std::this_thread::yield(); }
+    } );
+
+    while ( !pinned ) { std::this_thread::yield(); }
+
+    std::uint64_t const start = domain.epoch();
+    domain.retire<Item, mark_dead>( &a );
+
+    for ( int i = 0; i != 5; ++i )
+    {
+        domain.collect();
+    }
+
+    EXPECT( domain.epoch() <= start + 1 );
+    EXPECT( reclaimed == 0 );
+
+    done = true;
+    reader.join();
+
+    domain.collect();
+    domain.collect();
+
+    EXPECT( reclaimed == 1 );
+#else
+    EXPECT( !!"epoch_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "epoch_domain: Reclaims all retired objects on destruction" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Item a, b;
+
+    reclaimed = 0;
+    {
+        epoch_domain domain;
+        domain.retire<Item, mark_dead>( &a );
+        domain.retire<Item, mark_dead>( &b );
+    }
+
+    EXPECT( reclaimed == 2 );
+#else
+    EXPECT( !!"epoch_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "epoch_domain: Never reclaims an object a pinned reader can observe (stress)" " [epoch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    enum { readers = 4, writers = 2, updates = 5000, slots = 8 };
+
+    std::vector<Item> objects( writers * updates + slots );
+    std::vector< atomic_observer_ptr<Item> > sources( slots );
+    std::atomic<bool> done( false );
+    std::atomic<int>  violations( 0 );
+
+    for ( std::size_t i = 0; i != slots; ++i )
+    {
+        sources[i].store( make_observer( &objects[ writers * updates + i ] ) );
+    }
+
+    reclaimed = 0;
+    {
+        epoch_domain domain( 16 );
+        std::vector<std::thread> threads;
+
+        for ( int r = 0; r != readers; ++r )
+        {
+            threads.emplace_back( [&]()
+            {
+                while ( !done.load( std::memory_order_relaxed ) )
+                {
+                    epoch_guard guard( domain );
+
+                    // Scan all sources under a single pin:
+
+                    for ( auto & src : sources )
+                    {
+                        observer_ptr<Item> p = guard.load( src );
+
+                        if ( p && !p->alive.load( std::memory_order_relaxed ) )
+                            violations.fetch_add( 1 );
+                    }
+                }
+            } );
+        }
+
+        for ( int w = 0; w != writers; ++w )
+        {
+            threads.emplace_back( [&, w]()
+            {
+                for ( int i = 0; i != updates; ++i )
+                {
+                    Item * next = &objects[ static_cast<std::size_t>( w * updates + i ) ];
+                    auto & src = sources[ static_cast<std::size_t>( i % slots ) ];
+
+                    domain.retire<Item, mark_dead>( src.exchange( make_observer( next ) ).get() );
+                }
+            } );
+        }
+
+        for ( std::size_t t = readers; t != threads.size(); ++t )
+        {
+            threads[t].join();
+        }
+        done = true;
+
+        for ( std::size_t t = 0; t != readers; ++t )
+        {
+            threads[t].join();
+        }
+
+        for ( auto & src : sources )
+        {
+            domain.retire<Item, mark_dead>( src.exchange( observer_ptr<Item>() ).get() );
+        }
+    }
+
+    EXPECT( violations == 0 );
+    EXPECT( reclaimed == writers * updates + slots );
+#else
+    EXPECT( !!"epoch_domain is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -0,0 +1,107 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_flat_set.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <algorithm>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+CASE( "observer_flat_set: Allows to construct from unsorted observers with duplicates and iterates in the order of operator<" " [flat-set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[5] = {};
+    observer_flat_set<int> s = { make_observer( &arr[3] ), make_observer( &arr[1] ), observer_ptr<int>(), make_observer( &arr[3] ), make_observer( &arr[0] ) };
+
+    std::vector< observer_ptr<int> > const expected = { observer_ptr<int>(), make_observer( &arr[0] ), make_observer( &arr[1] ), make_observer( &arr[3] ) };
+
+    EXPECT( s.size() == 4u );
+    EXPECT( ( std::vector< observer_ptr<int> >( s.begin(), s.end() ) == expected ) );
+    EXPECT( ( s.sorted() == expected ) );
+    EXPECT( std::is_sorted( s.begin(), s.end() ) );
+    EXPECT( ( observer_flat_set<int>().begin() == observer_flat_set<int>().end() ) );
+#else
+    EXPECT( !!"observer_flat_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_flat_set: Allows to look up observers and their lower bound, for all sizes up to 70" " [flat-set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[142] = {};
+    bool same = true;
+
+    for ( std::size_t n = 0; n <= 70; ++n )
+    {
+        // the observers of the odd elements, in reverse:
+
+        std::vector< observer_ptr<int> > v;
+        for ( std::size_t i = n; i != 0; --i )
+        {
+            v.push_back( make_observer( &arr[ 2 * i - 1 ] ) );
+        }
+
+        observer_flat_set<int> const s( v );
+        std::sort( v.begin(), v.end() );
+
+        for ( int & x : arr )
+        {
+            observer_ptr<int> const key = make_observer( &x );
+            std::vector< observer_ptr<int> >::iterator const lb = std::lower_bound( v.begin(), v.end(), key );
+
+            same = same && s.contains( key ) == std::binary_search( v.begin(), v.end(), key );
+            same = same && ( lb == v.end() ? s.lower_bound( key ) == s.end() : *s.lower_bound( key ) == *lb );
+            same = same && ( s.find( key ) == s.end() ) != s.contains( key );
+        }
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"observer_flat_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_flat_set: Allows to insert a range of observers, merging them in order" " [flat-set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[100] = {};
+    observer_flat_set<int> s;
+    std::vector< observer_ptr<int> > expected;
+
+    for ( int step : { 3, 7, 2 } )
+    {
+        std::vector< observer_ptr<int> > added;
+        for ( int i = 99; i >= 0; i -= step )
+        {
+            added.push_back( make_observer( &arr[i] ) );
+            expected.push_back( make_observer( &arr[i] ) );
+        }
+
+        s.insert( added.begin(), added.end() );
+    }
+
+    std::sort( expected.begin(), expected.end() );
+    expected.erase( std::unique( expected.begin(), expected.end() ), expected.end() );
+
+    EXPECT( ( s.sorted() == expected ) );
+    EXPECT( s.contains( make_observer( &arr[99 - 21] ) ) );
+    EXPECT_NOT( s.contains( make_observer( &arr[99 - 1] ) ) );
+#else
+    EXPECT( !!"observer_flat_set is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
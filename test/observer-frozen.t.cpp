@@ -0,0 +1,103 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_frozen.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <set>
+# include <stdexcept>
+# include <string>
+# include <utility>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+CASE( "frozen_observer_set: Allows to look up the observers it is built from" " [frozen][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[4] = {};
+    frozen_observer_set<int> s = { make_observer( &arr[2] ), make_observer( &arr[0] ), make_observer( &arr[2] ) };
+
+    EXPECT( s.size() == 2u );
+    EXPECT( s.contains( make_observer( &arr[0] ) ) );
+    EXPECT( s.count( make_observer( &arr[2] ) ) == 1u );
+    EXPECT_NOT( s.contains( make_observer( &arr[1] ) ) );
+    EXPECT_NOT( s.contains( make_observer( &arr[3] ) ) );
+    EXPECT_NOT( s.contains( observer_ptr<int>() ) );
+
+    EXPECT( frozen_observer_set<int>().empty() );
+    EXPECT_NOT( frozen_observer_set<int>().contains( make_observer( &arr[0] ) ) );
+#else
+    EXPECT( !!"frozen_observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "frozen_observer_set: Places each observer of a large set in its own slot" " [frozen][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< long > arr( 5000 );
+    std::vector< observer_ptr<long> > keys;
+
+    for ( std::size_t i = 0; i < arr.size(); i += 2 )
+        keys.push_back( make_observer( &arr[i] ) );
+
+    frozen_observer_set<long> s( keys.begin(), keys.end() );
+
+    bool found = true;
+
+    for ( std::size_t i = 0; i != arr.size(); ++i )
+        found = found && s.contains( make_observer( &arr[i] ) ) == ( i % 2 == 0 );
+
+    std::set< observer_ptr<long> > const slots( s.begin(), s.end() );
+
+    EXPECT( found );
+    EXPECT( s.size() == keys.size() );
+    EXPECT( ( slots == std::set< observer_ptr<long> >( keys.begin(), keys.end() ) ) );
+#else
+    EXPECT( !!"frozen_observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "frozen_observer_map: Allows to look up and change the value of an observer" " [frozen][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[3] = {};
+    frozen_observer_map<int, std::string> m =
+    {
+        { make_observer( &arr[0] ), "a" },
+        { make_observer( &arr[1] ), "b" },
+        { make_observer( &arr[0] ), "c" },
+    };
+
+    EXPECT( m.size() == 2u );
+    EXPECT( m.at( make_observer( &arr[0] ) ) == "a" );
+    EXPECT( *m.find( make_observer( &arr[1] ) ) == "b" );
+    EXPECT_NOT( m.find( make_observer( &arr[2] ) ) );
+    EXPECT_NOT( m.contains( make_observer( &arr[2] ) ) );
+    EXPECT_THROWS_AS( m.at( make_observer( &arr[2] ) ), std::out_of_range );
+
+    m.at( make_observer( &arr[1] ) ) = "d";
+
+    frozen_observer_map<int, std::string> const & c = m;
+
+    EXPECT( c.at( make_observer( &arr[1] ) ) == "d" );
+    EXPECT_THROWS_AS( c.at( make_observer( &arr[2] ) ), std::out_of_range );
+    EXPECT( *c.find( make_observer( &arr[0] ) ) == "a" );
+    EXPECT( c.keys().size() == c.mapped().size() );
+#else
+    EXPECT( !!"frozen_observer_map is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
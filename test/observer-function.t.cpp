@@ -0,0 +1,122 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_function.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <string>
+# include <type_traits>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+int twice( int x ) { return 2 * x; }
+
+long square( long x ) { return x * x; }
+
+struct Counter
+{
+    int count;
+
+    int add( int n )            { return count += n; }
+    int peek( int offset ) const { return count + offset; }
+};
+
+struct Overloaded
+{
+    int operator()( int x )       { return x + 1; }
+    int operator()( int x ) const { return x + 2; }
+};
+
+// Sum f( 0 ) ... f( n - 1 ), as a callback-taking function would:
+
+int sum( function_ref< int( int ) > f, int n )
+{
+    int total = 0;
+
+    for ( int i = 0; i != n; ++i )
+        total += f( i );
+
+    return total;
+}
+
+#endif
+
+CASE( "function_ref: Is two words and trivially copyable" " [function][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    EXPECT( sizeof( function_ref< int( int ) > ) == 2 * sizeof( void * ) );
+#if nsop_CPP11_140 && ( !nsop_COMPILER_GNUC_VERSION || nsop_COMPILER_GNUC_VERSION >= 500 )
+    EXPECT( std::is_trivially_copyable< function_ref< int( int ) > >::value );
+#endif
+#else
+    EXPECT( !!"function_ref is not available (no C++11)" );
+#endif
+}
+
+CASE( "function_ref: Allows to call a lambda, a function object and a function" " [function][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int offset = 10;
+    Overloaded overloaded;
+    Overloaded const const_overloaded = {};
+
+    EXPECT( sum( [&]( int x ) { return x + offset; }, 4 ) == 46 );
+    EXPECT( sum( overloaded, 2 ) == 3 );
+    EXPECT( sum( const_overloaded, 2 ) == 5 );
+    EXPECT( sum( twice, 4 ) == 12 );
+    EXPECT( sum( &twice, 4 ) == 12 );
+    EXPECT( sum( square, 4 ) == 14 );
+
+    auto mutating = [&]( int x ) { offset += x; return offset; };
+    function_ref< int( int ) > f = mutating;
+    function_ref< int( int ) > g = twice;
+
+    EXPECT( f( 5 ) == 15 );
+    EXPECT( offset == 15 );
+
+    f.swap( g );
+
+    EXPECT( f( 5 ) == 10 );
+    EXPECT( g( 5 ) == 20 );
+
+    function_ref< void( std::string const & ) > discard = []( std::string const & s ) { return s.size(); };
+    discard( "x" );
+#else
+    EXPECT( !!"function_ref is not available (no C++11)" );
+#endif
+}
+
+CASE( "function_ref: Allows to call a member function of an observed object" " [function][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Counter counter = { 1 };
+
+    function_ref< int( int ) > add( member_t< decltype( &Counter::add ), &Counter::add >(), make_observer( &counter ) );
+    function_ref< int( int ) > peek( member_t< decltype( &Counter::peek ), &Counter::peek >(), make_observer<Counter const>( &counter ) );
+
+    EXPECT( add( 2 ) == 3 );
+    EXPECT( counter.count == 3 );
+    EXPECT( peek( 10 ) == 13 );
+    EXPECT( sum( add, 3 ) == 13 );
+#if nsop_CPP17_OR_GREATER
+    EXPECT( function_ref< int( int ) >( member<&Counter::peek>, make_observer( &counter ) )( 0 ) == 6 );
+#endif
+#else
+    EXPECT( !!"function_ref is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
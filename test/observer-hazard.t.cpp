@@ -0,0 +1,257 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_hazard.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <thread>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Reclamation marks an object dead instead of deleting it, so that a test can
+// detect access to a reclaimed object without undefined behaviour:
+
+struct Payload
+{
+    std::atomic<bool> alive;
+    int value;
+
+    Payload() : alive( true ), value( 0 ) {}
+};
+
+std::atomic<int> reclaimed( 0 );
+
+struct mark_dead
+{
+    void operator()( Payload * p ) const
+    {
+        p->alive.store( false, std::memory_order_relaxed );
+        reclaimed.fetch_add( 1, std::memory_order_relaxed );
+    }
+};
+
+#endif
+
+CASE( "hazard_domain: Allows to protect the object an atomic source observes" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    hazard_domain domain;
+    Payload a;
+    a.value = 7;
+
+    atomic_observer_ptr<Payload> src( &a );
+    std::atomic<Payload *> raw( &a );
+
+    hazard_guard<Payload> g1 = domain.protect( src );
+    hazard_guard<Payload> g2 = domain.protect( raw );
+    observer_ptr<Payload> o  = g1;
+
+    EXPECT( g1.get().get() == &a );
+    EXPECT( g2.get().get() == &a );
+    EXPECT( o.get() == &a );
+    EXPECT( g1->value == 7 );
+    EXPECT( (*g2).value == 7 );
+    EXPECT( !!g1 );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Allows to protect a null source" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    hazard_domain domain;
+    atomic_observer_ptr<Payload> src;
+
+    hazard_guard<Payload> g = domain.protect( src );
+
+    EXPECT( !g );
+    EXPECT( g.get().get() == static_cast<Payload *>( nullptr ) );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Defers reclamation of a retired object while a guard protects it" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    hazard_domain domain;
+    Payload a, b;
+    atomic_observer_ptr<Payload> src( &a );
+
+    reclaimed = 0;
+    {
+        hazard_guard<Payload> g = domain.protect( src );
+
+        src.store( make_observer( &b ) );
+        domain.retire<Payload, mark_dead>( &a );
+        domain.reclaim();
+
+        EXPECT( a.alive.load() );
+        EXPECT( reclaimed == 0 );
+    }
+    domain.reclaim();
+
+    EXPECT( !a.alive.load() );
+    EXPECT( reclaimed == 1 );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Allows to end the protection early, and to move a guard" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    hazard_domain domain;
+    Payload a;
+    atomic_observer_ptr<Payload> src( &a );
+
+    reclaimed = 0;
+
+    hazard_guard<Payload> g1 = domain.protect( src );
+    hazard_guard<Payload> g2( std::move( g1 ) );
+
+    EXPECT( !g1 );
+    EXPECT( g2.get().get() == &a );
+
+    domain.retire<Payload, mark_dead>( &a );
+    domain.reclaim();
+
+    EXPECT( reclaimed == 0 );
+
+    g2.reset();
+    domain.reclaim();
+
+    EXPECT( !g2 );
+    EXPECT( reclaimed == 1 );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Allows more guards than hazard slots per thread" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    enum { count = 3 * nsop_CONFIG_HAZARD_SLOTS_PER_THREAD };
+
+    hazard_domain domain;
+    std::vector<Payload> objects( count );
+    std::vector< atomic_observer_ptr<Payload> > sources( count );
+    std::vector< hazard_guard<Payload> > guards;
+
+    reclaimed = 0;
+
+    for ( std::size_t i = 0; i != count; ++i )
+    {
+        sources[i].store( make_observer( &objects[i] ) );
+        guards.push_back( domain.protect( sources[i] ) );
+        domain.retire<Payload, mark_dead>( &objects[i] );
+    }
+    domain.reclaim();
+
+    EXPECT( reclaimed == 0 );
+
+    guards.clear();
+    domain.reclaim();
+
+    EXPECT( reclaimed == count );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Reclaims all retired objects on destruction" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Payload a, b;
+
+    reclaimed = 0;
+    {
+        hazard_domain domain;
+        domain.retire<Payload, mark_dead>( &a );
+        domain.retire<Payload, mark_dead>( &b );
+    }
+
+    EXPECT( reclaimed == 2 );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+CASE( "hazard_domain: Never reclaims an object a reader protects (stress)" " [hazard][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    enum { readers = 4, writers = 2, updates = 5000 };
+
+    std::vector<Payload> objects( writers * updates + 1 );
+    std::atomic<bool> done( false );
+    std::atomic<int>  violations( 0 );
+
+    reclaimed = 0;
+    {
+        hazard_domain domain( 16 );
+        atomic_observer_ptr<Payload> src( &objects.back() );
+        std::vector<std::thread> threads;
+
+        for ( int r = 0; r != readers; ++r )
+        {
+            threads.emplace_back( [&]()
+            {
+                while ( !done.load( std::memory_order_relaxed ) )
+                {
+                    hazard_guard<Payload> g = domain.protect( src );
+
+                    if ( g && !g->alive.load( std::memory_order_relaxed ) )
+                        violations.fetch_add( 1 );
+                }
+            } );
+        }
+
+        for ( int w = 0; w != writers; ++w )
+        {
+            threads.emplace_back( [&, w]()
+            {
+                for ( int i = 0; i != updates; ++i )
+                {
+                    Payload * next = &objects[ static_cast<std::size_t>( w * updates + i ) ];
+                    domain.retire<Payload, mark_dead>( src.exchange( make_observer( next ) ).get() );
+                }
+            } );
+        }
+
+        for ( std::size_t t = readers; t != threads.size(); ++t )
+        {
+            threads[t].join();
+        }
+        done = true;
+
+        for ( std::size_t t = 0; t != readers; ++t )
+        {
+            threads[t].join();
+        }
+
+        domain.retire<Payload, mark_dead>( src.exchange( observer_ptr<Payload>() ).get() );
+    }
+
+    EXPECT( violations == 0 );
+    EXPECT( reclaimed == writers * updates + 1 );
+#else
+    EXPECT( !!"hazard_domain is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
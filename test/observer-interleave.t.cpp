@@ -0,0 +1,147 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_interleave.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <stdexcept>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+struct Node
+{
+    int key;
+    int value;
+    observer_ptr<Node> next;
+};
+
+// Hash table of bucket lists; bucket b holds keys b, b + buckets, b + 2 * buckets, ...:
+
+struct Table
+{
+    explicit Table( int buckets, int keys )
+    : nodes( static_cast<std::size_t>( keys ) ), heads( static_cast<std::size_t>( buckets ) )
+    {
+        for ( int k = 0; k != keys; ++k )
+        {
+            Node & node = nodes[ static_cast<std::size_t>( k ) ];
+            observer_ptr<Node> & head = heads[ static_cast<std::size_t>( k % buckets ) ];
+
+            node.key   = k;
+            node.value = 10 * k;
+            node.next  = head;
+            head       = make_observer( &node );
+        }
+    }
+
+    std::vector< Node > nodes;
+    std::vector< observer_ptr<Node> > heads;
+};
+
+#endif
+
+CASE( "chase_interleaved: Allows to look up keys in a table of bucket lists" " [interleave][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Table table( 7, 100 );
+
+    std::vector< int > keys;
+    std::vector< observer_ptr<Node> > starts;
+
+    for ( int k = 0; k < 120; k += 3 )
+    {
+        keys.push_back( k );
+        starts.push_back( table.heads[ static_cast<std::size_t>( k % 7 ) ] );
+    }
+
+    std::vector< int > found( keys.size(), -1 );
+
+    chase_interleaved( starts.begin(), starts.end(), [&]( std::size_t i, observer_ptr<Node> node )
+    {
+        if ( node->key == keys[ i ] )
+        {
+            found[ i ] = node->value;
+            return observer_ptr<Node>();
+        }
+        return node->next;
+    }, 4 );
+
+    bool all_found = true;
+    for ( std::size_t i = 0; i != keys.size(); ++i )
+    {
+        all_found = all_found && found[ i ] == ( keys[ i ] < 100 ? 10 * keys[ i ] : -1 );
+    }
+
+    EXPECT( all_found );
+#else
+    EXPECT( !!"chase_interleaved is not available (no C++11)" );
+#endif
+}
+
+CASE( "chase_interleaved: Visits the nodes of each chain in order, also of empty chains and for any width" " [interleave][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Table table( 5, 23 );
+
+    for ( std::size_t width : { 0u, 1u, 2u, 5u, 64u } )
+    {
+        std::vector< observer_ptr<Node> > starts( table.heads );
+        starts.push_back( observer_ptr<Node>() );
+
+        std::vector< std::vector< int > > visited( starts.size() );
+
+        chase_interleaved( starts.begin(), starts.end(), [&]( std::size_t i, observer_ptr<Node> node )
+        {
+            visited[ i ].push_back( node->key );
+            return node->next;
+        }, width );
+
+        bool in_order = visited.back().empty();
+        for ( std::size_t b = 0; b != table.heads.size(); ++b )
+        {
+            std::vector< int > expected;
+            for ( observer_ptr<Node> node = table.heads[ b ]; node; node = node->next )
+            {
+                expected.push_back( node->key );
+            }
+            in_order = in_order && visited[ b ] == expected;
+        }
+
+        EXPECT( in_order );
+    }
+#else
+    EXPECT( !!"chase_interleaved is not available (no C++11)" );
+#endif
+}
+
+CASE( "chase_interleaved: Propagates an exception from visiting a node" " [interleave][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Table table( 3, 30 );
+
+    EXPECT_THROWS_AS( chase_interleaved( table.heads.begin(), table.heads.end(), []( std::size_t, observer_ptr<Node> node )
+    {
+        if ( node->key == 13 )
+            throw std::runtime_error( "key 13" );
+        return node->next;
+    } ), std::runtime_error );
+#else
+    EXPECT( !!"chase_interleaved is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
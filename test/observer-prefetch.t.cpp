@@ -0,0 +1,180 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_prefetch.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <list>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Forward iterator over pointers that records the positions it dereferences:
+
+struct recording_iterator
+{
+    typedef std::forward_iterator_tag iterator_category;
+    typedef int *                     value_type;
+    typedef std::ptrdiff_t            difference_type;
+    typedef int * const *             pointer;
+    typedef int * const &             reference;
+
+    int * const * pos;
+    int * const * first;
+    std::vector<int> * visits;
+
+    reference operator*() const
+    {
+        visits->push_back( static_cast<int>( pos - first ) );
+        return *pos;
+    }
+
+    recording_iterator & operator++()
+    {
+        ++pos;
+        return *this;
+    }
+
+    friend bool operator==( recording_iterator const & a, recording_iterator const & b ) { return a.pos == b.pos; }
+    friend bool operator!=( recording_iterator const & a, recording_iterator const & b ) { return a.pos != b.pos; }
+};
+
+std::vector<int> prefetched( std::size_t distance )
+{
+    int arr[] = { 1, 2, 3, 4, };
+    int * const ptrs[] = { &arr[0], &arr[1], &arr[2], &arr[3], };
+    std::vector<int> visits;
+
+    recording_iterator const first = { ptrs    , ptrs, &visits };
+    recording_iterator const last  = { ptrs + 4, ptrs, &visits };
+
+    for ( prefetch_iterator<recording_iterator> pos( first, last, distance ), end( last ); pos != end; ++pos ) {}
+
+    return visits;
+}
+
+#endif
+
+CASE( "prefetch: Allows to prefetch the object an observer or a pointer refers to" " [prefetch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    observer_ptr<int> p( &a );
+    observer_ptr<int> n;
+
+    prefetch( p );
+    prefetch( n );
+    prefetch( &a );
+    prefetch<prefetch_access::write, prefetch_locality::none>( p );
+    prefetch<prefetch_access::read , prefetch_locality::low >( &a );
+
+    EXPECT( *p == 7 );
+#else
+    EXPECT( !!"prefetch is not available (no C++11)" );
+#endif
+}
+
+CASE( "prefetch_iterator: Allows to iterate over a sequence of observers" " [prefetch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[] = { 1, 2, 3, 4, 5, };
+    std::vector< observer_ptr<int> > v;
+
+    for ( int & x : arr )
+    {
+        v.push_back( make_observer( &x ) );
+    }
+
+    int sum = 0;
+    for ( observer_ptr<int> p : make_prefetch_range( v, 2 ) )
+    {
+        sum += *p;
+    }
+
+    EXPECT( sum == 15 );
+
+    prefetch_iterator< std::vector< observer_ptr<int> >::iterator > pos( v.begin(), v.end(), 3 );
+
+    EXPECT(   ( pos.base() == v.begin() ) );
+    EXPECT( *pos->get() == 1 );
+    EXPECT( **pos++ == 1 );
+    EXPECT( **pos == 2 );
+#else
+    EXPECT( !!"prefetch_iterator is not available (no C++11)" );
+#endif
+}
+
+CASE( "prefetch_iterator: Allows a distance beyond the end and an empty sequence" " [prefetch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    std::vector< observer_ptr<int> > v( 1, make_observer( &a ) );
+    std::vector< observer_ptr<int> > e;
+
+    int sum = 0;
+    for ( observer_ptr<int> p : make_prefetch_range( v, 100 ) )
+    {
+        sum += *p;
+    }
+
+    int count = 0;
+    for ( observer_ptr<int> p : make_prefetch_range<prefetch_access::write>( e ) )
+    {
+        count += !!p;
+    }
+
+    EXPECT( sum   == 7 );
+    EXPECT( count == 0 );
+#else
+    EXPECT( !!"prefetch_iterator is not available (no C++11)" );
+#endif
+}
+
+CASE( "prefetch_iterator: Prefetches each element once ahead of the current one, none for distance 0" " [prefetch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    EXPECT( prefetched( 0 ).empty() );
+    EXPECT( ( prefetched( 1 ) == std::vector<int>{ 0, 1, 2, 3 } ) );
+    EXPECT( ( prefetched( 2 ) == std::vector<int>{ 0, 1, 2, 3 } ) );
+#else
+    EXPECT( !!"prefetch_iterator is not available (no C++11)" );
+#endif
+}
+
+CASE( "prefetch_iterator: Allows to iterate over a forward sequence of pointers" " [prefetch][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[] = { 1, 2, 3, };
+    std::list< int * > l;
+
+    for ( int & x : arr )
+    {
+        l.push_back( &x );
+    }
+
+    int sum = 0;
+    for ( int * p : make_prefetch_range( l.begin(), l.end(), 1 ) )
+    {
+        sum += *p;
+    }
+
+    EXPECT( sum == 6 );
+#else
+    EXPECT( !!"prefetch_iterator is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -59,38 +59,26 @@ CASE( "__cplusplus" "[.stdc++]" )
 
 CASE( "Compiler version" "[.compiler]" )
 {
-#if nsop_USES_STD_OBSERVER_PTR
-    std::cout << "(Compiler version not available: using std::experimental::observer_ptr)\n";
-#else
     nsop_PRESENT( nsop_COMPILER_CLANG_VERSION );
     nsop_PRESENT( nsop_COMPILER_GNUC_VERSION );
     nsop_PRESENT( nsop_COMPILER_MSVC_VERSION );
-#endif
 }
 
 CASE( "Presence of C++ language features" "[.stdlanguage]" )
 {
-#if nsop_USES_STD_OBSERVER_PTR
-    std::cout << "(Presence of C++ language features not available: using std::experimental::observer_ptr)\n";
-#else
     nsop_PRESENT( nsop_HAVE_CONSTEXPR_11 );
     nsop_PRESENT( nsop_HAVE_CONSTEXPR_14 );
     nsop_PRESENT( nsop_HAVE_EXPLICIT_CONVERSION );
     nsop_PRESENT( nsop_HAVE_NOEXCEPT );
     nsop_PRESENT( nsop_HAVE_NULLPTR );
-#endif
 }
 
 CASE( "Presence of C++ library features" "[.stdlibrary]" )
 {
-#if nsop_USES_STD_OBSERVER_PTR
-    std::cout << "(Presence of C++ library features not available: using std::experimental::observer_ptr)\n";
-#else
     nsop_PRESENT( nsop_HAVE_STD_DECAY );
     nsop_PRESENT( nsop_HAVE_STD_DECLVAL );
     nsop_PRESENT( nsop_HAVE_STD_SMART_PTRS );
     nsop_PRESENT( nsop_HAVE_TYPEOF );
-#endif
 
 #if defined _HAS_CPP0X
     nsop_PRESENT( _HAS_CPP0X );
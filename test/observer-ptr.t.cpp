@@ -7,10 +7,30 @@
 //
 
 #include "observer-ptr-main.t.hpp"
+#include <cstring>
 #include <iostream>
+#include <new>
+
+#if nsop_CPP11_OR_GREATER
+# include <algorithm>
+# include <memory>
+# include <set>
+# include <unordered_set>
+# include <vector>
+#endif
 
 using namespace nonstd;
 
+#if nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+
+struct deref_check_failure {};
+
+void nonstd::deref_check_handler()
+{
+    throw deref_check_failure();
+}
+#endif
+
 namespace {
 
 CASE( "Disallows to delete the observer_ptr unless implicit conversion allowed" )
@@ -191,6 +211,27 @@ CASE( "Allows to retrieve the member pointed to" )
     EXPECT( sp->a == s.a );
 }
 
+CASE( "Allows to check the dereference of a null observer per nsop_CONFIG_DEREF_CHECK" " [deref-check][extension]" )
+{
+#if !nsop_USES_STD_OBSERVER_PTR
+# if   nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+    observer_ptr<S> sp;
+
+    EXPECT_THROWS_AS( *sp, bad_observer_access );
+    EXPECT_THROWS_AS( sp.operator->(), bad_observer_access );
+# elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+    observer_ptr<S> sp;
+
+    EXPECT_THROWS_AS( *sp, deref_check_failure );
+    EXPECT_THROWS_AS( sp.operator->(), deref_check_failure );
+# else
+    EXPECT( !!"dereference check does not report via an exception (nsop_CONFIG_DEREF_CHECK)" );
+# endif
+#else
+    EXPECT( !!"dereference check is not available (using std::experimental::observer_ptr)" );
+#endif
+}
+
 CASE( "Allows to test for a non-null pointer via conversion to bool" )
 {
     int a = 7;
@@ -479,6 +520,744 @@ CASE( "Specialized: Allows to compute hash" )
 #endif // nsop_CPP11_OR_GREATER
 }
 
+// observer_ptr extensions:
+
+#if nsop_CPP11_OR_GREATER
+
+struct alignas(8) Aligned8 { int a; };
+
+struct Arena
+{
+    static Aligned8 objects[4];
+    static Aligned8 * base() { return objects; }
+};
+
+Aligned8 Arena::objects[4] = { { 1 }, { 2 }, { 3 }, { 4 } };
+
+// Arena that starts at the second object of Arena, so that the first one lies before it:
+
+struct LaterArena
+{
+    static Aligned8 * base() { return &Arena::objects[1]; }
+};
+
+struct Relocatable
+{
+    int value;
+    offset_observer_ptr<int> p;
+};
+
+struct alignas(64) Aligned64 { int a; };
+
+// Derived class with a base at a non-zero offset:
+
+struct Base1 { int a; };
+struct Base2 { int b; };
+struct Derived : Base1, Base2 { int c; };
+
+// Hash that std::hash of the nonstd observers yields for the observed pointer:
+
+template< class T >
+std::size_t pointer_hash( T * p )
+{
+#if nsop_CONFIG_MIXING_HASH
+    return observer_hash()( p );
+#else
+    return std::hash<T *>()( p );
+#endif
+}
+
+#endif
+
+CASE( "tagged_observer_ptr: Allows to store a tag in the low alignment bits of the pointer" " [tagged][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Aligned8 a = { 7 };
+    tagged_observer_ptr<Aligned8, 3> p( &a, 5 );
+
+    EXPECT( sizeof( p ) == sizeof( Aligned8 * ) );
+    EXPECT( p.get() == &a );
+    EXPECT( p.tag() == 5u );
+    EXPECT( p->a == 7 );
+    EXPECT( (*p).a == 7 );
+
+    p.set_tag( 2 );
+
+    EXPECT( p.get() == &a );
+    EXPECT( p.tag() == 2u );
+#else
+    EXPECT( !!"tagged_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "tagged_observer_ptr: Allows to store a tag in the unused upper bits of the pointer" " [tagged][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+# if nsop_CONFIG_TAGGED_POINTER_HIGH_BITS >= 16
+    Aligned8 a = { 7 };
+    tagged_observer_ptr<Aligned8, 19> p( &a, 0x7ffff );
+
+    EXPECT( sizeof( p ) == sizeof( Aligned8 * ) );
+    EXPECT( p.low_bits  ==  3u );
+    EXPECT( p.high_bits == 16u );
+    EXPECT( p.get() == &a );
+    EXPECT( p.tag() == 0x7ffffu );
+
+    p.set_tag( 0x40001 );
+
+    EXPECT( p.get() == &a );
+    EXPECT( p.tag() == 0x40001u );
+# else
+    EXPECT( !!"tagged_observer_ptr: no unused upper pointer bits on this platform (nsop_CONFIG_TAGGED_POINTER_HIGH_BITS)" );
+# endif
+#else
+    EXPECT( !!"tagged_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "tagged_observer_ptr: Allows to check the dereference of a null observer per nsop_CONFIG_DEREF_CHECK" " [tagged][deref-check][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+# if   nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+    tagged_observer_ptr<S, 2> sp( nsop_NULLPTR, 3 );
+
+    EXPECT_THROWS_AS( *sp, bad_observer_access );
+    EXPECT_THROWS_AS( sp.operator->(), bad_observer_access );
+# elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+    tagged_observer_ptr<S, 2> sp( nsop_NULLPTR, 3 );
+
+    EXPECT_THROWS_AS( *sp, deref_check_failure );
+    EXPECT_THROWS_AS( sp.operator->(), deref_check_failure );
+# else
+    EXPECT( !!"dereference check does not report via an exception (nsop_CONFIG_DEREF_CHECK)" );
+# endif
+#else
+    EXPECT( !!"tagged_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "tagged_observer_ptr: Allows to reset, release and swap, and to convert to observer_ptr" " [tagged][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Aligned8 a = { 7 }, b = { 9 };
+    tagged_observer_ptr<Aligned8, 2> p = make_tagged_observer<2>( &a, 1 );
+    tagged_observer_ptr<Aligned8, 2> q = make_tagged_observer<2>( &b, 3 );
+
+    swap( p, q );
+
+    EXPECT( p.get() == &b );
+    EXPECT( p.tag() == 3u );
+    EXPECT( q.get() == &a );
+    EXPECT( q.tag() == 1u );
+
+    observer_ptr<Aligned8> o = p;
+
+    EXPECT( o.get() == &b );
+
+    p.reset( &a, 2 );
+
+    EXPECT( p.get() == &a );
+    EXPECT( p.tag() == 2u );
+    EXPECT( p.release() == &a );
+    EXPECT( !p );
+    EXPECT( p.tag() == 0u );
+#else
+    EXPECT( !!"tagged_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "tagged_observer_ptr: Allows to compare and hash the pointer, ignoring the tag" " [tagged][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Aligned8 arr[2] = { { 7 }, { 9 } };
+    tagged_observer_ptr<Aligned8      , 3> p( &arr[0], 1 );
+    tagged_observer_ptr<Aligned8      , 3> q( &arr[0], 6 );
+    tagged_observer_ptr<Aligned8 const, 3> r( &arr[1], 6 );
+
+    EXPECT(     ( p == q ) );
+    EXPECT_NOT( ( p != q ) );
+    EXPECT(     ( p != r ) );
+    EXPECT(     ( p <  r ) );
+    EXPECT(     ( p <= q ) );
+    EXPECT(     ( r >  q ) );
+    EXPECT(     ( r >= q ) );
+    EXPECT(     ( p != nullptr ) );
+    EXPECT_NOT( ( nullptr == p ) );
+
+    typedef std::hash< tagged_observer_ptr<Aligned8, 3> > tagged_hash;
+
+    EXPECT( tagged_hash()( p ) == tagged_hash()( q ) );
+    EXPECT( tagged_hash()( p ) == pointer_hash( &arr[0] ) );
+#else
+    EXPECT( !!"tagged_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_ptr32: Allows to observe an object in an arena via a 32-bit offset" " [observer32][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    observer_ptr32<Aligned8, Arena> p;
+    observer_ptr32<Aligned8, Arena> q( &Arena::objects[0] );
+    observer_ptr32<Aligned8, Arena> r = make_observer32<Arena>( &Arena::objects[2] );
+
+    EXPECT( sizeof( p ) == 4u );
+    EXPECT( !p );
+    EXPECT( p.get() == static_cast<Aligned8 *>( nullptr ) );
+    EXPECT( q.get() == &Arena::objects[0] );
+    EXPECT( q->a == 1 );
+    EXPECT( (*r).a == 3 );
+#else
+    EXPECT( !!"observer_ptr32 is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_ptr32: Allows to convert from and to observer_ptr" " [observer32][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    observer_ptr32<Aligned8, Arena> p( make_observer( &Arena::objects[1] ) );
+    observer_ptr<Aligned8> o = p;
+    observer_ptr32<Aligned8 const, Arena> c = p;
+
+    EXPECT( o.get() == &Arena::objects[1] );
+    EXPECT( c.get() == &Arena::objects[1] );
+#else
+    EXPECT( !!"observer_ptr32 is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_ptr32: Allows to reset, release and swap" " [observer32][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    observer_ptr32<Aligned8, Arena> p( &Arena::objects[0] );
+    observer_ptr32<Aligned8, Arena> q( &Arena::objects[3] );
+
+    swap( p, q );
+
+    EXPECT( p.get() == &Arena::objects[3] );
+    EXPECT( q.get() == &Arena::objects[0] );
+
+    p.reset( &Arena::objects[1] );
+
+    EXPECT( p.get() == &Arena::objects[1] );
+    EXPECT( p.release() == &Arena::objects[1] );
+    EXPECT( !p );
+#else
+    EXPECT( !!"observer_ptr32 is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_ptr32: Allows to check observing an object outside the arena per nsop_CONFIG_DEREF_CHECK" " [observer32][deref-check][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    observer_ptr32<Aligned8, LaterArena> p( &Arena::objects[2] );
+
+    EXPECT( p.get() == &Arena::objects[2] );
+# if   nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+    EXPECT_THROWS_AS( ( observer_ptr32<Aligned8, LaterArena>( &Arena::objects[0] ) ), bad_observer_access );
+    EXPECT_THROWS_AS( p.reset( &Arena::objects[0] ), bad_observer_access );
+# elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+    EXPECT_THROWS_AS( ( observer_ptr32<Aligned8, LaterArena>( &Arena::objects[0] ) ), deref_check_failure );
+    EXPECT_THROWS_AS( p.reset( &Arena::objects[0] ), deref_check_failure );
+# else
+    EXPECT( !!"arena check does not report via an exception (nsop_CONFIG_DEREF_CHECK)" );
+# endif
+#else
+    EXPECT( !!"observer_ptr32 is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_ptr32: Allows to compare and hash, ordering as the observed pointers" " [observer32][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    observer_ptr32<Aligned8      , Arena> n;
+    observer_ptr32<Aligned8      , Arena> p( &Arena::objects[0] );
+    observer_ptr32<Aligned8      , Arena> q( &Arena::objects[0] );
+    observer_ptr32<Aligned8 const, Arena> r( &Arena::objects[2] );
+
+    EXPECT(     ( p == q ) );
+    EXPECT(     ( p != r ) );
+    EXPECT(     ( n <  p ) );
+    EXPECT(     ( p <  r ) );
+    EXPECT(     ( p <= q ) );
+    EXPECT(     ( r >  p ) );
+    EXPECT(     ( r >= p ) );
+    EXPECT(     ( n == nullptr ) );
+    EXPECT(     ( nullptr != p ) );
+
+    typedef std::hash< observer_ptr32<Aligned8, Arena> > observer32_hash;
+
+    EXPECT( observer32_hash()( p ) == pointer_hash( &Arena::objects[0] ) );
+#else
+    EXPECT( !!"observer_ptr32 is not available (no C++11)" );
+#endif
+}
+
+CASE( "offset_observer_ptr: Allows to observe an object via a self-relative offset" " [offset][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    offset_observer_ptr<int> n;
+    offset_observer_ptr<int> p( &a );
+    offset_observer_ptr<int> q( make_observer( &a ) );
+
+    EXPECT( !n );
+    EXPECT( n.get() == static_cast<int *>( nullptr ) );
+    EXPECT( p.get() == &a );
+    EXPECT( q.get() == &a );
+    EXPECT( *p == 7 );
+#else
+    EXPECT( !!"offset_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "offset_observer_ptr: Allows to copy, observing the same object" " [offset][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    offset_observer_ptr<int> p( &a );
+    offset_observer_ptr<int> q( p );
+    offset_observer_ptr<int const> r( p );
+    offset_observer_ptr<int> s;
+
+    s = p;
+
+    EXPECT( q.get() == &a );
+    EXPECT( r.get() == &a );
+    EXPECT( s.get() == &a );
+    EXPECT( p.offset() != q.offset() );
+#else
+    EXPECT( !!"offset_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "offset_observer_ptr: Allows to relocate the observer together with the observed object" " [offset][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    alignas( Relocatable ) unsigned char region1[ sizeof( Relocatable ) ];
+    alignas( Relocatable ) unsigned char region2[ sizeof( Relocatable ) ];
+
+    Relocatable * r1 = new( region1 ) Relocatable();
+    r1->value = 42;
+    r1->p.reset( &r1->value );
+
+    std::memcpy( region2, region1, sizeof( region1 ) );
+    Relocatable * r2 = reinterpret_cast<Relocatable *>( region2 );
+
+    EXPECT( r2->p.get() == &r2->value );
+    EXPECT( *r2->p == 42 );
+#else
+    EXPECT( !!"offset_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "offset_observer_ptr: Allows to convert to observer_ptr, to reset, release and swap" " [offset][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    offset_observer_ptr<int> p( &a );
+    offset_observer_ptr<int> q( &b );
+    observer_ptr<int> o = p;
+
+    EXPECT( o.get() == &a );
+
+    swap( p, q );
+
+    EXPECT( p.get() == &b );
+    EXPECT( q.get() == &a );
+
+    p.reset( &a );
+
+    EXPECT( p.get() == &a );
+    EXPECT( p.release() == &a );
+    EXPECT( !p );
+#else
+    EXPECT( !!"offset_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "offset_observer_ptr: Allows to compare and hash the observed pointer" " [offset][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[] = { 7, 9, };
+    offset_observer_ptr<int      > n;
+    offset_observer_ptr<int      > p( &arr[0] );
+    offset_observer_ptr<int      > q( &arr[0] );
+    offset_observer_ptr<int const> r( &arr[1] );
+
+    EXPECT(     ( p == q ) );
+    EXPECT(     ( p != r ) );
+    EXPECT(     ( p <  r ) );
+    EXPECT(     ( p <= q ) );
+    EXPECT(     ( r >  p ) );
+    EXPECT(     ( r >= p ) );
+    EXPECT(     ( n == nullptr ) );
+    EXPECT(     ( nullptr != p ) );
+    EXPECT( std::hash< offset_observer_ptr<int> >()( p ) == pointer_hash( &arr[0] ) );
+#else
+    EXPECT( !!"offset_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "nonnull_observer_ptr: Allows construction from a non-null pointer, observer_ptr or reference" " [nonnull][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7;
+    nonnull_observer_ptr<int> p( &a );
+    nonnull_observer_ptr<int> q( make_observer( &a ) );
+    nonnull_observer_ptr<int> r( a );
+    nonnull_observer_ptr<int const> c = p;
+
+    EXPECT( p.get() == &a );
+    EXPECT( q.get() == &a );
+    EXPECT( r.get() == &a );
+    EXPECT( c.get() == &a );
+    EXPECT( *p == 7 );
+    EXPECT( !std::is_default_constructible< nonnull_observer_ptr<int> >::value );
+    EXPECT( !( std::is_constructible< nonnull_observer_ptr<int>, std::nullptr_t >::value ) );
+    EXPECT( !( std::is_constructible< bool, nonnull_observer_ptr<int> >::value ) );
+#else
+    EXPECT( !!"nonnull_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "nonnull_observer_ptr: Allows to make a non-null observer and to convert it to observer_ptr" " [nonnull][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    S s;
+    nonnull_observer_ptr<S> p = make_nonnull_observer( &s );
+    nonnull_observer_ptr<S> q = make_nonnull_observer( s );
+    nonnull_observer_ptr<S> r = make_nonnull_observer( make_observer( &s ) );
+    observer_ptr<S> o = p;
+
+    EXPECT( p->a == 7 );
+    EXPECT( q.get() == &s );
+    EXPECT( r.get() == &s );
+    EXPECT( o.get() == &s );
+#else
+    EXPECT( !!"nonnull_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "nonnull_observer_ptr: Allows to check the construction from null per nsop_CONFIG_DEREF_CHECK" " [nonnull][deref-check][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+# if   nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_THROW
+    int * n = nsop_NULLPTR;
+
+    EXPECT_THROWS_AS( nonnull_observer_ptr<int>{ n }, bad_observer_access );
+    EXPECT_THROWS_AS( make_nonnull_observer( observer_ptr<int>() ), bad_observer_access );
+# elif nsop_CONFIG_DEREF_CHECK == nsop_DEREF_CHECK_HANDLER
+    int * n = nsop_NULLPTR;
+
+    EXPECT_THROWS_AS( nonnull_observer_ptr<int>{ n }, deref_check_failure );
+    EXPECT_THROWS_AS( make_nonnull_observer( observer_ptr<int>() ), deref_check_failure );
+# else
+    EXPECT( !!"null check does not report via an exception (nsop_CONFIG_DEREF_CHECK)" );
+# endif
+#else
+    EXPECT( !!"nonnull_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "nonnull_observer_ptr: Allows to reset and swap" " [nonnull][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    nonnull_observer_ptr<int> p( &a );
+    nonnull_observer_ptr<int> q( &b );
+
+    swap( p, q );
+
+    EXPECT( p.get() == &b );
+    EXPECT( q.get() == &a );
+
+    p.reset( &a );
+
+    EXPECT( p.get() == &a );
+#else
+    EXPECT( !!"nonnull_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "nonnull_observer_ptr: Allows to compare and hash" " [nonnull][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[] = { 7, 9, };
+    nonnull_observer_ptr<int      > p( &arr[0] );
+    nonnull_observer_ptr<int      > q( &arr[0] );
+    nonnull_observer_ptr<int const> r( &arr[1] );
+
+    EXPECT(     ( p == q ) );
+    EXPECT(     ( p != r ) );
+    EXPECT(     ( p <  r ) );
+    EXPECT(     ( p <= q ) );
+    EXPECT(     ( r >  p ) );
+    EXPECT(     ( r >= p ) );
+    EXPECT( std::hash< nonnull_observer_ptr<int> >()( p ) == pointer_hash( &arr[0] ) );
+#else
+    EXPECT( !!"nonnull_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+#if nsop_CPP11_OR_GREATER
+
+// y[i] += a[i] * b[i], for distinct buffers:
+
+void multiply_add( restrict_observer_ptr<long> y, restrict_observer_ptr<long const> a, restrict_observer_ptr<long const> b, std::ptrdiff_t n )
+{
+    for ( std::ptrdiff_t i = 0; i != n; ++i )
+    {
+        y[i] += a[i] * b[i];
+    }
+}
+
+#endif
+
+CASE( "restrict_observer_ptr: Allows construction from a pointer, observer_ptr or nullptr" " [restrict][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    S s;
+    restrict_observer_ptr<S> p( &s );
+    restrict_observer_ptr<S> q( make_observer( &s ) );
+    restrict_observer_ptr<S const> c = p;
+    restrict_observer_ptr<S> n( nullptr );
+    restrict_observer_ptr<S> d;
+
+    EXPECT( p.get() == &s );
+    EXPECT( q.get() == &s );
+    EXPECT( c.get() == &s );
+    EXPECT( p->a == 7 );
+    EXPECT( (*c).a == 7 );
+    EXPECT( !n );
+    EXPECT( !d );
+    EXPECT( sizeof( restrict_observer_ptr<S> ) == sizeof( S * ) );
+    EXPECT( std::is_trivially_copyable< restrict_observer_ptr<S> >::value );
+#else
+    EXPECT( !!"restrict_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "restrict_observer_ptr: Allows to index the observed array in a kernel" " [restrict][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::ptrdiff_t const n = 37;
+    std::vector<long> y( n ), a( n ), b( n );
+
+    for ( std::ptrdiff_t i = 0; i != n; ++i )
+    {
+        y[ static_cast<std::size_t>( i ) ] = i;
+        a[ static_cast<std::size_t>( i ) ] = 2 * i;
+        b[ static_cast<std::size_t>( i ) ] = 3;
+    }
+
+    multiply_add( make_restrict_observer( y.data() ), make_restrict_observer<long const>( a.data() ), make_restrict_observer<long const>( b.data() ), n );
+
+    bool same = true;
+
+    for ( std::ptrdiff_t i = 0; i != n; ++i )
+    {
+        same = same && y[ static_cast<std::size_t>( i ) ] == 7 * i;
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"restrict_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "restrict_observer_ptr: Allows to convert to observer_ptr, to reset, release and swap" " [restrict][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int a = 7, b = 9;
+    restrict_observer_ptr<int> p( &a );
+    restrict_observer_ptr<int> q( &b );
+    observer_ptr<int> o = p;
+
+    EXPECT( o.get() == &a );
+
+    swap( p, q );
+
+    EXPECT( p.get() == &b );
+    EXPECT( q.get() == &a );
+    EXPECT( p.release() == &b );
+    EXPECT( !p );
+
+    p.reset( &a );
+
+    EXPECT( p.get() == &a );
+#else
+    EXPECT( !!"restrict_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "restrict_observer_ptr: Allows to compare and hash" " [restrict][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[] = { 7, 9, };
+    restrict_observer_ptr<int      > p( &arr[0] );
+    restrict_observer_ptr<int      > q( &arr[0] );
+    restrict_observer_ptr<int const> r( &arr[1] );
+    restrict_observer_ptr<int      > n;
+
+    EXPECT(     ( p == q ) );
+    EXPECT(     ( p != r ) );
+    EXPECT(     ( p <  r ) );
+    EXPECT(     ( p <= q ) );
+    EXPECT(     ( r >  p ) );
+    EXPECT(     ( r >= p ) );
+    EXPECT(     ( n == nullptr ) );
+    EXPECT(     ( nullptr != p ) );
+    EXPECT( std::hash< restrict_observer_ptr<int> >()( p ) == pointer_hash( &arr[0] ) );
+#else
+    EXPECT( !!"restrict_observer_ptr is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_hash: Allows to hash pointers and observers of the same address alike" " [hash][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Aligned8 arr[2] = { { 7 }, { 9 } };
+    observer_hash h;
+
+    EXPECT( h( &arr[0] ) == h( make_observer( &arr[0] ) ) );
+    EXPECT( h( &arr[0] ) == h( tagged_observer_ptr<Aligned8, 3>( &arr[0], 5 ) ) );
+    EXPECT( h( &arr[0] ) == h( nonnull_observer_ptr<Aligned8>( &arr[0] ) ) );
+    EXPECT( h( &arr[0] ) != h( &arr[1] ) );
+    EXPECT( h( observer_ptr<Aligned8>() ) == h( static_cast<Aligned8 *>( nullptr ) ) );
+#if !nsop_USES_STD_OBSERVER_PTR
+    EXPECT( std::hash< observer_ptr<Aligned8> >()( make_observer( &arr[0] ) ) == pointer_hash( &arr[0] ) );
+#endif
+#else
+    EXPECT( !!"observer_hash is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_hash: Spreads addresses of aligned objects over the low bits" " [hash][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::size_t const n = 1024;
+    std::vector< Aligned64 > objects( n );
+    std::vector< bool > used( n );
+
+    for ( Aligned64 & object : objects )
+    {
+        used[ observer_hash()( make_observer( &object ) ) & ( n - 1 ) ] = true;
+    }
+
+    // uniformly distributed hashes use 1 - 1/e or 63% of the buckets, addresses 1/64:
+
+    EXPECT( std::count( used.begin(), used.end(), true ) > static_cast<std::ptrdiff_t>( n / 2 ) );
+#else
+    EXPECT( !!"observer_hash is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_equal, observer_less: Allow to compare pointers and observers by address" " [transparent][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[2] = {};
+    observer_equal eq;
+    observer_less  lt;
+
+    EXPECT(     eq( &arr[0], make_observer( &arr[0] ) ) );
+    EXPECT(     eq( make_observer( &arr[0] ), make_nonnull_observer( &arr[0] ) ) );
+    EXPECT_NOT( eq( make_observer( &arr[0] ), &arr[1] ) );
+    EXPECT(     lt( make_observer( &arr[0] ), &arr[1] ) );
+    EXPECT_NOT( lt( &arr[1], make_observer( &arr[0] ) ) );
+    EXPECT(     lt( observer_ptr<int>(), &arr[0] ) );
+    EXPECT(     lt( make_observer( &arr[0] ), &arr[1] ) == ( make_observer( &arr[0] ) < make_observer( &arr[1] ) ) );
+#else
+    EXPECT( !!"observer_equal, observer_less are not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_equal, observer_less: Compare observers of related types as their composite pointer type" " [transparent][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Derived d;
+    Base2 * b = &d;
+
+    EXPECT( static_cast<void *>( b ) != static_cast<void *>( &d ) );
+    EXPECT(     observer_equal()( b, make_observer( &d ) ) );
+    EXPECT_NOT( observer_less()( b, make_observer( &d ) ) );
+    EXPECT_NOT( observer_less()( make_observer( &d ), b ) );
+#else
+    EXPECT( !!"observer_equal, observer_less are not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_key_hash: Hashes a key as an observer of the key type" " [transparent][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Derived d;
+    observer_key_hash<Base2> h;
+    observer_key_hash<Base2, observer_hash> mh;
+
+    EXPECT( h( &d ) == std::hash< observer_ptr<Base2> >()( make_observer<Base2>( &d ) ) );
+    EXPECT( h( make_observer( &d ) ) == h( static_cast<Base2 *>( &d ) ) );
+    EXPECT( mh( make_observer( &d ) ) == observer_hash()( static_cast<Base2 *>( &d ) ) );
+#else
+    EXPECT( !!"observer_key_hash is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_less: Allows to look up a pointer in a std::set of observers (C++14)" " [transparent][extension]" )
+{
+#if nsop_CPP14_OR_GREATER
+    int arr[3] = {};
+    std::set< observer_ptr<int>, observer_less > s = { make_observer( &arr[0] ), make_observer( &arr[1] ) };
+
+    EXPECT( ( s.find( &arr[1] ) != s.end() ) );
+    EXPECT( s.count( &arr[0] ) == 1u );
+    EXPECT( s.count( &arr[2] ) == 0u );
+    EXPECT( ( s.lower_bound( &arr[1] ) == s.find( make_observer( &arr[1] ) ) ) );
+#else
+    EXPECT( !!"heterogeneous lookup in std::set is not available (no C++14)" );
+#endif
+}
+
+CASE( "observer_key_hash, observer_equal: Allow to look up a pointer in a std::unordered_set of observers (C++20)" " [transparent][extension]" )
+{
+#if nsop_CPP20_OR_GREATER && defined(__cpp_lib_generic_unordered_lookup)
+    int arr[3] = {};
+    std::unordered_set< observer_ptr<int>, observer_key_hash<int>, observer_equal > s = { make_observer( &arr[0] ), make_observer( &arr[1] ) };
+
+    EXPECT( ( s.find( &arr[1] ) != s.end() ) );
+    EXPECT( s.contains( &arr[0] ) );
+    EXPECT( s.count( &arr[2] ) == 0u );
+#else
+    EXPECT( !!"heterogeneous lookup in std::unordered_set is not available (no C++20)" );
+#endif
+}
+
+CASE( "observer_less, observer_key_hash: Allow to look up a smart pointer if implicit conversion is allowed" " [transparent][smart-ptr][extension]" )
+{
+#if nsop_CPP14_OR_GREATER && nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_UNIQUE_PTR && nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_SHARED_PTR && nsop_HAVE_STD_SMART_PTRS
+    std::unique_ptr<int> up( new int( 7 ) );
+    std::shared_ptr<int> sp( new int( 9 ) );
+    std::set< observer_ptr<int>, observer_less > s = { make_observer( up.get() ) };
+
+    EXPECT( s.count( up ) == 1u );
+    EXPECT( s.count( sp ) == 0u );
+    EXPECT( observer_equal()( sp, make_observer( sp.get() ) ) );
+    EXPECT( observer_key_hash<int>()( up ) == std::hash< observer_ptr<int> >()( make_observer( up.get() ) ) );
+#else
+    EXPECT( !!"lookup with a smart pointer is not enabled (no C++14 or no nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_SMART_PTR)" );
+#endif
+}
+
+CASE( "observer_equal, observer_less: Do not accept a smart pointer if implicit conversion is not allowed" " [transparent][smart-ptr][extension]" )
+{
+#if nsop_CPP17_OR_GREATER && !nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_UNIQUE_PTR && !nsop_CONFIG_ALLOW_IMPLICIT_CONVERSION_FROM_SHARED_PTR
+    EXPECT(     ( std::is_invocable< observer_equal, observer_ptr<int>, int * >::value ) );
+    EXPECT_NOT( ( std::is_invocable< observer_equal, std::unique_ptr<int> const &, int * >::value ) );
+    EXPECT_NOT( ( std::is_invocable< observer_less, observer_ptr<int>, std::shared_ptr<int> const & >::value ) );
+    EXPECT_NOT( ( std::is_invocable< observer_key_hash<int>, std::unique_ptr<int> const & >::value ) );
+#else
+    EXPECT( !!"std::is_invocable is not available (no C++17) or implicit conversion from a smart pointer is allowed" );
+#endif
+}
+
 } // namespace
 
 // end of file
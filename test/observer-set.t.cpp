@@ -0,0 +1,282 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_set.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <map>
+# include <set>
+# include <string>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Hash that sends all keys to a few home slots, for long runs that collide:
+
+struct colliding_hash
+{
+    std::size_t operator()( observer_ptr<int> p ) const
+    {
+        return ( reinterpret_cast<std::uintptr_t>( p.get() ) / sizeof( int ) ) % 3;
+    }
+};
+
+// Hash that sends all keys to one home slot:
+
+struct constant_hash
+{
+    std::size_t operator()( observer_ptr<int> ) const
+    {
+        return 0;
+    }
+};
+
+// Pseudo-random sequence of inserts and erases of observers of arr, against std::set:
+
+template< class Set >
+bool same_as_std_set( Set & s, int * arr, std::size_t n )
+{
+    std::set< observer_ptr<int> > expected;
+    unsigned long seed = 12345;
+    bool same = true;
+
+    for ( int step = 0; step != 4000; ++step )
+    {
+        seed = seed * 1103515245UL + 12345UL;
+        observer_ptr<int> const key = make_observer( arr + ( seed >> 8 ) % n );
+
+        if ( ( seed >> 20 ) % 3 != 0 )
+        {
+            same = same && s.insert( key ).second == expected.insert( key ).second;
+        }
+        else
+        {
+            same = same && s.erase( key ) == expected.erase( key );
+        }
+        same = same && s.size() == expected.size();
+    }
+
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        same = same && s.contains( make_observer( arr + i ) ) == ( expected.count( make_observer( arr + i ) ) == 1 );
+    }
+    return same;
+}
+
+#endif
+
+CASE( "observer_set: Allows to insert, look up and erase observers" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[3] = {};
+    observer_set<int> s;
+
+    EXPECT( s.empty() );
+    EXPECT( s.insert( make_observer( &arr[0] ) ).second );
+    EXPECT( s.insert( make_observer( &arr[1] ) ).second );
+    EXPECT_NOT( s.insert( make_observer( &arr[0] ) ).second );
+
+    EXPECT( s.size() == 2u );
+    EXPECT( s.contains( make_observer( &arr[0] ) ) );
+    EXPECT( s.count( make_observer( &arr[1] ) ) == 1u );
+    EXPECT_NOT( s.contains( make_observer( &arr[2] ) ) );
+    EXPECT_NOT( s.contains( observer_ptr<int>() ) );
+
+    EXPECT( s.erase( make_observer( &arr[0] ) ) == 1u );
+    EXPECT( s.erase( make_observer( &arr[0] ) ) == 0u );
+    EXPECT_NOT( s.contains( make_observer( &arr[0] ) ) );
+    EXPECT( s.size() == 1u );
+
+    s.clear();
+
+    EXPECT( s.empty() );
+    EXPECT_NOT( s.contains( make_observer( &arr[1] ) ) );
+#else
+    EXPECT( !!"observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_set: Keeps its observers when growing and when erasing from runs of colliding keys" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< int > arr( 300 );
+
+    observer_set< int > s;
+    observer_set< int, colliding_hash > c;
+
+    EXPECT( same_as_std_set( s, arr.data(), arr.size() ) );
+    EXPECT( same_as_std_set( c, arr.data(), 60 ) );
+#else
+    EXPECT( !!"observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_set: Grows with the load, not with the length of runs, for a hash that sends all keys to one slot" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< int > arr( 1000 );
+
+    observer_set< int, constant_hash > s;
+
+    for ( int & x : arr )
+    {
+        s.insert( make_observer( &x ) );
+    }
+
+    bool found = true;
+
+    for ( int & x : arr )
+    {
+        found = found && s.contains( make_observer( &x ) );
+    }
+
+    EXPECT( found );
+    EXPECT( s.size() == arr.size() );
+    EXPECT( s.capacity() <= 2048u );
+
+    observer_set< int, constant_hash > t;
+
+    EXPECT( same_as_std_set( t, arr.data(), 200 ) );
+#else
+    EXPECT( !!"observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_set: Allows to iterate over its observers" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[100] = {};
+    observer_set<int> s( 100 );
+    std::set< observer_ptr<int> > expected;
+
+    EXPECT( s.capacity() >= 100u );
+
+    for ( int & x : arr )
+    {
+        s.insert( make_observer( &x ) );
+        expected.insert( make_observer( &x ) );
+    }
+
+    std::set< observer_ptr<int> > visited( s.begin(), s.end() );
+
+    EXPECT( ( visited == expected ) );
+    EXPECT( static_cast<std::size_t>( std::distance( s.begin(), s.end() ) ) == s.size() );
+    EXPECT( ( observer_set<int>().begin() == observer_set<int>().end() ) );
+    EXPECT( s.begin()->get() == ( *s.begin() ).get() );
+#else
+    EXPECT( !!"observer_set is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_map: Allows to insert, look up and erase values by observer" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[3] = {};
+    observer_map<int, std::string> m;
+
+    EXPECT( m.insert( make_observer( &arr[0] ), "a" ).second );
+    EXPECT_NOT( m.insert( make_observer( &arr[0] ), "b" ).second );
+    EXPECT_NOT( m.insert_or_assign( make_observer( &arr[0] ), "c" ).second );
+
+    m[ make_observer( &arr[1] ) ] = "d";
+
+    EXPECT( m.size() == 2u );
+    EXPECT( *m.find( make_observer( &arr[0] ) ) == "c" );
+    EXPECT( *m.find( make_observer( &arr[1] ) ) == "d" );
+    EXPECT_NOT( m.find( make_observer( &arr[2] ) ) );
+    EXPECT( m[ make_observer( &arr[2] ) ].empty() );
+    EXPECT( m.size() == 3u );
+
+    EXPECT( m.erase( make_observer( &arr[1] ) ) == 1u );
+    EXPECT_NOT( m.contains( make_observer( &arr[1] ) ) );
+    EXPECT( m.count( make_observer( &arr[0] ) ) == 1u );
+#else
+    EXPECT( !!"observer_map is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_map: Keeps the value with its key when growing and erasing" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< int > arr( 60 );
+    observer_map< int, std::string, colliding_hash > m;
+    std::map< observer_ptr<int>, std::string > expected;
+
+    for ( std::size_t i = 0; i != arr.size(); ++i )
+    {
+        m.insert( make_observer( &arr[i] ), std::to_string( i ) );
+        expected[ make_observer( &arr[i] ) ] = std::to_string( i );
+    }
+
+    for ( std::size_t i = 0; i < arr.size(); i += 3 )
+    {
+        m.erase( make_observer( &arr[i] ) );
+        expected.erase( make_observer( &arr[i] ) );
+    }
+
+    bool same = m.size() == expected.size();
+
+    for ( std::size_t i = 0; i != arr.size(); ++i )
+    {
+        observer_ptr<std::string const> const value = static_cast< observer_map< int, std::string, colliding_hash > const & >( m ).find( make_observer( &arr[i] ) );
+
+        same = same && ( i % 3 == 0 ? !value : value && *value == std::to_string( i ) );
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"observer_map is not available (no C++11)" );
+#endif
+}
+
+CASE( "observer_map: Allows to iterate over keys and values" " [set][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    int arr[50] = {};
+    observer_map<int, int> m;
+
+    for ( int i = 0; i != 50; ++i )
+    {
+        m[ make_observer( &arr[i] ) ] = i;
+    }
+
+    for ( std::pair< observer_ptr<int>, int & > kv : m )
+    {
+        kv.second += 50;
+    }
+
+    for ( observer_map<int, int>::iterator it = m.begin(); it != m.end(); ++it )
+    {
+        it->second += 50;
+    }
+
+    bool same = true;
+    int count = 0;
+
+    for ( std::pair< observer_ptr<int>, int const & > kv : static_cast< observer_map<int, int> const & >( m ) )
+    {
+        same = same && kv.second == kv.first.get() - arr + 100;
+        ++count;
+    }
+
+    EXPECT( same );
+    EXPECT( count == 50 );
+#else
+    EXPECT( !!"observer_map is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -0,0 +1,235 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_slot_map.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <string>
+# include <type_traits>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+CASE( "checked_observer: Is eight bytes and trivially copyable" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    EXPECT( sizeof( checked_observer<std::string> ) == 8u );
+    EXPECT( std::is_trivially_copyable< checked_observer<std::string> >::value );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Allows to resolve to an observer of the element" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<std::string> map;
+    slot_map<std::string> const & cmap = map;
+
+    checked_observer<std::string> k = map.insert( "hello" );
+
+    observer_ptr<std::string>       p = k.resolve( map );
+    observer_ptr<std::string const> q = k.resolve( cmap );
+
+    EXPECT( p.get() != static_cast<std::string *>( nullptr ) );
+    EXPECT( *p == "hello" );
+    EXPECT( *q == "hello" );
+    EXPECT( map.find( k ).get() == p.get() );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Resolves to null when default-constructed" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+    map.insert( 7 );
+
+    checked_observer<int> k;
+
+    EXPECT( !map.contains( k ) );
+    EXPECT( !k.resolve( map ) );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Resolves to null for slot 0 and for a slot out of range, whatever the generation" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k0( 0, 1 );
+    checked_observer<int> kn( 7, 1 );
+
+    EXPECT( !map.contains( k0 ) );
+    EXPECT( !k0.resolve( map ) );
+    EXPECT( !map.erase( k0 ) );
+    EXPECT( !map.contains( kn ) );
+
+    checked_observer<int> k = map.insert( 7 );
+
+    EXPECT( !map.contains( k0 ) );
+    EXPECT( !map.erase( k0 ) );
+    EXPECT( !map.contains( checked_observer<int>( k.index() + 1, k.generation() ) ) );
+    EXPECT( !map.contains( checked_observer<int>( 0xffffffffu, k.generation() ) ) );
+    EXPECT( *k.resolve( map ) == 7 );
+    EXPECT( map.size() == 1u );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Resolves to null once the element is erased, also when its slot is reused" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 7 );
+
+    EXPECT( map.erase( k1 ) );
+    EXPECT( !k1.resolve( map ) );
+    EXPECT( !map.erase( k1 ) );
+
+    checked_observer<int> k2 = map.insert( 9 );
+
+    EXPECT( k2.index() == k1.index() );
+    EXPECT( k2.generation() != k1.generation() );
+    EXPECT( !k1.resolve( map ) );
+    EXPECT( *k2.resolve( map ) == 9 );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Resolves to null with the generation of a free slot" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 7 );
+    checked_observer<int> k2 = map.insert( 8 );
+
+    EXPECT( map.erase( k1 ) );
+
+    checked_observer<int> const freed( k1.index(), k1.generation() + 1 );
+
+    EXPECT( !map.contains( freed ) );
+    EXPECT( !freed.resolve( map ) );
+    EXPECT( !map.erase( freed ) );
+
+    checked_observer<int> k3 = map.insert( 9 );
+    checked_observer<int> k4 = map.insert( 10 );
+
+    EXPECT( k3.index() == k1.index() );
+    EXPECT( ( k3 != freed ) );
+    EXPECT( !freed.resolve( map ) );
+    EXPECT( *k2.resolve( map ) == 8 );
+    EXPECT( *k3.resolve( map ) == 9 );
+    EXPECT( *k4.resolve( map ) == 10 );
+    EXPECT( k4.index() != k3.index() );
+    EXPECT( map.size() == 3u );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "checked_observer: Allows to compare and hash" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 7 );
+    checked_observer<int> k2 = map.insert( 9 );
+    checked_observer<int> k3 = k1;
+
+    EXPECT(     ( k1 == k3 ) );
+    EXPECT(     ( k1 != k2 ) );
+    EXPECT( std::hash< checked_observer<int> >()( k1 ) == std::hash< checked_observer<int> >()( k3 ) );
+#else
+    EXPECT( !!"checked_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "slot_map: Stores elements contiguously and keeps handles valid when erasing others" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 1 );
+    checked_observer<int> k2 = map.insert( 2 );
+    checked_observer<int> k3 = map.emplace( 3 );
+
+    EXPECT( map.size() == 3u );
+    EXPECT( map.end() - map.begin() == 3 );
+
+    map.erase( k1 );
+
+    EXPECT( map.size() == 2u );
+    EXPECT( *k2.resolve( map ) == 2 );
+    EXPECT( *k3.resolve( map ) == 3 );
+
+    int sum = 0;
+    for ( int v : map )
+    {
+        sum += v;
+    }
+
+    EXPECT( sum == 5 );
+    EXPECT( &*map.begin() == map.data() );
+#else
+    EXPECT( !!"slot_map is not available (no C++11)" );
+#endif
+}
+
+CASE( "slot_map: Allows to obtain the handle of an element in the contiguous storage" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 1 );
+    checked_observer<int> k2 = map.insert( 2 );
+    map.erase( k1 );
+
+    EXPECT( ( map.key_of( map.cbegin() ) == k2 ) );
+#else
+    EXPECT( !!"slot_map is not available (no C++11)" );
+#endif
+}
+
+CASE( "slot_map: Allows to clear, invalidating all handles" " [slot-map][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    slot_map<int> map;
+
+    checked_observer<int> k1 = map.insert( 1 );
+    checked_observer<int> k2 = map.insert( 2 );
+
+    map.clear();
+
+    EXPECT( map.empty() );
+    EXPECT( !map.contains( k1 ) );
+    EXPECT( !map.contains( k2 ) );
+
+    checked_observer<int> k3 = map.insert( 3 );
+
+    EXPECT( *k3.resolve( map ) == 3 );
+    EXPECT( !k1.resolve( map ) );
+    EXPECT( !k2.resolve( map ) );
+#else
+    EXPECT( !!"slot_map is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -0,0 +1,121 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_sort.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <algorithm>
+# include <random>
+# include <vector>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Observers of the elements of arr in random order, some twice, some null:
+
+std::vector< observer_ptr<double> > make_shuffled( std::vector< double > & arr, std::size_t n )
+{
+    std::mt19937 gen( 42 );
+    std::uniform_int_distribution< std::size_t > pick( 0, arr.size() );
+
+    std::vector< observer_ptr<double> > v;
+
+    for ( std::size_t i = 0; i != n; ++i )
+    {
+        std::size_t const k = pick( gen );
+        v.push_back( k == arr.size() ? observer_ptr<double>() : make_observer( &arr[k] ) );
+    }
+    return v;
+}
+
+#endif
+
+CASE( "sort_by_address: Sorts observers in the order of operator<" " [sort][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< double > arr( 100000 );
+    bool same = true;
+
+    for ( std::size_t n : { 0u, 1u, 2u, 100u, 255u, 256u, 1000u, 300000u } )
+    {
+        std::vector< observer_ptr<double> > v = make_shuffled( arr, n );
+        std::vector< observer_ptr<double> > expected( v );
+
+        std::sort( expected.begin(), expected.end() );
+        sort_by_address( v );
+
+        same = same && ( v == expected );
+    }
+
+    EXPECT( same );
+#else
+    EXPECT( !!"sort_by_address is not available (no C++11)" );
+#endif
+}
+
+CASE( "unique_by_address: Removes consecutive observers of the same address" " [sort][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< double > arr( 1000 );
+    std::vector< observer_ptr<double> > v = make_shuffled( arr, 5000 );
+    std::vector< observer_ptr<double> > expected( v );
+
+    std::sort( expected.begin(), expected.end() );
+    expected.erase( std::unique( expected.begin(), expected.end() ), expected.end() );
+
+    sort_by_address( v );
+    unique_by_address( v );
+
+    EXPECT(     ( v == expected ) );
+#else
+    EXPECT( !!"unique_by_address is not available (no C++11)" );
+#endif
+}
+
+CASE( "group_by_page: Splits observers sorted by address into groups per page" " [sort][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    std::vector< double > arr( 10000 );
+    std::vector< observer_ptr<double> > v = make_shuffled( arr, 20000 );
+
+    sort_by_address( v );
+
+    std::vector< page_group<double> > groups = group_by_page( v, 4096 );
+
+    std::size_t total = 0;
+    bool per_page = true;
+
+    for ( std::size_t g = 0; g != groups.size(); ++g )
+    {
+        total += groups[g].size();
+        per_page = per_page && groups[g].size() != 0
+            && ( g == 0 || groups[g - 1].page < groups[g].page )
+            && ( g == 0 || groups[g - 1].end() == groups[g].begin() );
+
+        for ( observer_ptr<double> p : groups[g] )
+        {
+            per_page = per_page && ( reinterpret_cast<std::uintptr_t>( p.get() ) & ~std::uintptr_t( 4095 ) ) == groups[g].page;
+        }
+    }
+
+    EXPECT( per_page );
+    EXPECT( total == v.size() );
+    EXPECT( group_by_page( std::vector< observer_ptr<double> >() ).empty() );
+#else
+    EXPECT( !!"group_by_page is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file
@@ -0,0 +1,153 @@
+// Copyright 2026-2026 by Martin Moene
+//
+// nonstd::observer_ptr<> is a C++98 onward implementation for std::observer_ptr as of C++17.
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include "observer-ptr-main.t.hpp"
+#include "nonstd/observer_variant.hpp"
+
+#if nsop_CPP11_OR_GREATER
+# include <set>
+# include <string>
+# include <unordered_set>
+#endif
+
+using namespace nonstd;
+
+namespace {
+
+#if nsop_CPP11_OR_GREATER
+
+// Nodes of an expression tree, without virtual functions:
+
+struct Number;
+struct Negate;
+struct Add;
+
+typedef variant_observer< Number, Negate, Add > Expr;
+
+struct Number   { long value; };
+struct Negate   { Expr operand; };
+struct Add      { Expr left; Expr right; };
+
+// Evaluate an expression by recursive visits:
+
+struct Eval
+{
+    long operator()( observer_ptr<Number> p ) const { return p->value; }
+    long operator()( observer_ptr<Negate> p ) const { return -visit( *this, p->operand ); }
+    long operator()( observer_ptr<Add> p )    const { return visit( *this, p->left ) + visit( *this, p->right ); }
+};
+
+// A visitor that names the node type and reads its first member:
+
+struct Describe
+{
+    std::string operator()( observer_ptr<Number> p ) const { return "number " + std::to_string( p->value ); }
+    std::string operator()( observer_ptr<Negate> )   const { return "negate"; }
+    std::string operator()( observer_ptr<Add> )      const { return "add"; }
+};
+
+#endif
+
+CASE( "variant_observer: Is one pointer in size and tells the type of the observed object" " [variant][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Number number = { 7 };
+    Add add = { Expr( &number ), Expr( &number ) };
+
+    Expr n( make_observer( &number ) );
+    Expr a( &add );
+    Expr null;
+
+    EXPECT( sizeof( Expr ) == sizeof( void * ) );
+
+    EXPECT( n.index() == 0u );
+    EXPECT( a.index() == 2u );
+    EXPECT( n.holds<Number>() );
+    EXPECT_NOT( n.holds<Add>() );
+    EXPECT( a.holds<Add>() );
+    EXPECT( n.get() == static_cast<void const *>( &number ) );
+    EXPECT( a.get() == static_cast<void const *>( &add ) );
+
+    EXPECT( n.get_if<Number>().get() == &number );
+    EXPECT( a.get_if<Add>().get() == &add );
+    EXPECT( !a.get_if<Number>() );
+
+    EXPECT( !null );
+    EXPECT_NOT( null.holds<Number>() );
+    EXPECT( !null.get_if<Number>() );
+    EXPECT( !Expr( observer_ptr<Add>() ) );
+
+    a.reset();
+
+    EXPECT( ( a == nullptr ) );
+#else
+    EXPECT( !!"variant_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "variant_observer: Allows to visit the observed object as its own type" " [variant][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Number number = { 7 };
+    Negate negate = { Expr( &number ) };
+    Add add = { Expr( &number ), Expr( &negate ) };
+
+    EXPECT( visit( Describe(), Expr( &number ) ) == "number 7" );
+    EXPECT( visit( Describe(), Expr( &negate ) ) == "negate" );
+    EXPECT( Expr( &add ).visit( Describe() ) == "add" );
+
+    Describe const describe;
+    Expr const e( &negate );
+
+    EXPECT( visit( describe, e ) == "negate" );
+    EXPECT( visit( Eval(), Expr( &add ) ) == 0 );
+    EXPECT( visit( Eval(), Expr( &negate ) ) == -7 );
+#else
+    EXPECT( !!"variant_observer is not available (no C++11)" );
+#endif
+}
+
+CASE( "variant_observer: Compares and hashes as the untagged address" " [variant][extension]" )
+{
+#if nsop_CPP11_OR_GREATER
+    Number numbers[2] = { { 1 }, { 2 } };
+    Add add = { Expr( &numbers[0] ), Expr( &numbers[1] ) };
+
+    Expr const n0( &numbers[0] );
+    Expr const n1( &numbers[1] );
+    Expr const a( &add );
+
+    EXPECT( ( n0 == Expr( make_observer( &numbers[0] ) ) ) );
+    EXPECT( ( n0 != n1 ) );
+    EXPECT( ( n0 <  n1 ) );
+    EXPECT( ( n1 >  n0 ) );
+    EXPECT( ( n0 <= n0 ) );
+    EXPECT( ( n1 >= n0 ) );
+    EXPECT( ( n0 != nullptr ) );
+    EXPECT( ( Expr() == nullptr ) );
+    EXPECT( ( n0 < a ) == std::less< void const * >()( &numbers[0], &add ) );
+
+    EXPECT( std::hash<Expr>()( n0 ) == std::hash<Expr>()( Expr( &numbers[0] ) ) );
+#if !nsop_CONFIG_MIXING_HASH
+    EXPECT( std::hash<Expr>()( n0 ) == std::hash< observer_ptr<Number> >()( make_observer( &numbers[0] ) ) );
+#endif
+
+    std::set< Expr > ordered = { a, n1, n0, n0 };
+    std::unordered_set< Expr > hashed = { a, n1, n0, n0 };
+
+    EXPECT( ordered.size() == 3u );
+    EXPECT( hashed.size() == 3u );
+    EXPECT( hashed.count( n1 ) == 1u );
+#else
+    EXPECT( !!"variant_observer is not available (no C++11)" );
+#endif
+}
+
+} // namespace
+
+// end of file